@@ -58,6 +58,7 @@ UObject* UVortexMechanismFactory::FactoryCreateFile(UClass* InClass, UObject* In
     vortexMechanismAsset->AutomatedMappingImport = true;
     vortexMechanismAsset->MechanismFilepath.FilePath = Filename;
     FPaths::MakePathRelativeTo(vortexMechanismAsset->MechanismFilepath.FilePath, *FPaths::ProjectContentDir());
+    vortexMechanismAsset->UpdateMechanismFilepathName();
 
     UBlueprint* importedMechanismBlueprint = FKismetEditorUtilities::CreateBlueprintUsingAsset(vortexMechanismAsset, true);
 
@@ -342,16 +343,25 @@ UObject* UVortexMechanismFactory::FactoryCreateFile(UClass* InClass, UObject* In
                     {
                         const VortexMeshData& MeshData = MeshDataArray[j];
 
-                        //Create the vertex
+                        //Convert the vertex attributes once, they are shared by the vertex instances
                         int32 NumVertex = MeshData.vertexCount;
+                        TArray<FVector> SectionPositions;
+                        SectionPositions.SetNumUninitialized(NumVertex);
+                        VortexIntegrationUtilities::ConvertTranslations(MeshData.vertices, NumVertex, SectionPositions.GetData());
+                        TArray<FVector> SectionNormals;
+                        SectionNormals.SetNumUninitialized(MeshData.normalCount);
+                        VortexIntegrationUtilities::ConvertDirections(MeshData.normals, MeshData.normalCount, SectionNormals.GetData());
+                        TArray<FVector> SectionTangents;
+                        SectionTangents.SetNumUninitialized(MeshData.tangentCount);
+                        VortexIntegrationUtilities::ConvertDirections(MeshData.tangents, MeshData.tangentCount, SectionTangents.GetData());
+
+                        //Create the vertex
                         TMap<int32, FVertexID> VertexIndexToVertexID;
                         VertexIndexToVertexID.Reserve(NumVertex);
                         for (int32 VertexIndex = 0; VertexIndex < NumVertex; ++VertexIndex)
                         {
-                            double pos[3] = { MeshData.vertices[VertexIndex * 3], MeshData.vertices[VertexIndex * 3 + 1], MeshData.vertices[VertexIndex * 3 + 2] };
-
                             const FVertexID VertexID = MeshDescription.CreateVertex();
-                            VertexPositions[VertexID] = VortexIntegrationUtilities::ConvertTranslation(pos);
+                            VertexPositions[VertexID] = SectionPositions[VertexIndex];
                             VertexIndexToVertexID.Add(VertexIndex, VertexID);
                         }
                         //Create the VertexInstance
@@ -384,21 +394,13 @@ UObject* UVortexMechanismFactory::FactoryCreateFile(UClass* InClass, UObject* In
                             FVector TangentY(0, 1, 0);
                             FVector TangentZ(0, 0, 1);
 
-                            if (MeshData.normalCount > 0)
+                            if (SectionNormals.IsValidIndex(VertexIndex))
                             {
-                                double Normal[3] = {
-                                    MeshData.normals[VertexIndex * 3],
-                                    MeshData.normals[VertexIndex * 3 + 1],
-                                    MeshData.normals[VertexIndex * 3 + 2] };
-                                TangentZ = VortexIntegrationUtilities::ConvertDirection(Normal);
+                                TangentZ = SectionNormals[VertexIndex];
 
-                                if (MeshData.tangentCount > 0)
+                                if (SectionTangents.IsValidIndex(VertexIndex))
                                 {
-                                    double Tangent[3] = {
-                                        MeshData.tangents[VertexIndex * 3],
-                                        MeshData.tangents[VertexIndex * 3 + 1],
-                                        MeshData.tangents[VertexIndex * 3 + 2] };
-                                    TangentX = VortexIntegrationUtilities::ConvertDirection(Tangent);
+                                    TangentX = SectionTangents[VertexIndex];
                                 }
                             }
                                                         
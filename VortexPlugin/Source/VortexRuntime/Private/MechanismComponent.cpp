@@ -1,10 +1,14 @@
 #include "MechanismComponent.h"
 #include "VortexIntegrationUtilities.h"
 #include "VortexRuntime.h"
+#include "VortexMechanismInstancer.h"
 #include <Engine/Classes/GameFramework/Actor.h>
 #include "Runtime/Core/Public/Misc/Paths.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Engine/Engine.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/UnrealType.h"
 
 #include <string>
 #include <vector>
@@ -20,11 +24,203 @@ DECLARE_CYCLE_STAT(TEXT("GetVHLValueGraphicsMesh"), STAT_GetVHLValueGraphicsMesh
 DECLARE_CYCLE_STAT(TEXT("GetVHLValueMaterial"), STAT_GetVHLValueMaterial, STATGROUP_VortexMechanism);
 DECLARE_CYCLE_STAT(TEXT("SetVHLValue"), STAT_SetVHLValue, STATGROUP_VortexMechanism);
 DECLARE_CYCLE_STAT(TEXT("SetVHLValueTransform"), STAT_SetVHLValueTransform, STATGROUP_VortexMechanism);
+DECLARE_CYCLE_STAT(TEXT("ApplyQueuedVHLInputs"), STAT_ApplyQueuedVHLInputs, STATGROUP_VortexMechanism);
+DECLARE_CYCLE_STAT(TEXT("FlushVHLBatchInputs"), STAT_FlushVHLBatchInputs, STATGROUP_VortexMechanism);
+DECLARE_CYCLE_STAT(TEXT("GatherVHLBatchOutputs"), STAT_GatherVHLBatchOutputs, STATGROUP_VortexMechanism);
+DECLARE_CYCLE_STAT(TEXT("GatherSceneTransforms"), STAT_GatherSceneTransforms, STATGROUP_VortexMechanism);
+DECLARE_CYCLE_STAT(TEXT("ApplySceneTransforms"), STAT_ApplySceneTransforms, STATGROUP_VortexMechanism);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SkippedGraphicNodes"), STAT_SkippedGraphicNodes, STATGROUP_VortexMechanism);
+DECLARE_CYCLE_STAT(TEXT("DispatchVHLOutputChanges"), STAT_DispatchVHLOutputChanges, STATGROUP_VortexMechanism);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VHLOutputChanges"), STAT_VHLOutputChanges, STATGROUP_VortexMechanism);
+
+namespace
+{
+    // Graphic node twins closer than this to their Vortex transform are not moved, in centimeters and radians
+    const float GraphicNodeTransformTolerance = 1.e-3f;
+
+    // Moves a graphic node twin in a single transform propagation, unless it is already there
+    bool SyncGraphicNodeTwin(USceneComponent* Twin, const FTransform& Transform)
+    {
+        if (Twin->GetComponentTransform().Equals(Transform, GraphicNodeTransformTolerance))
+        {
+            return false;
+        }
+
+        // Vortex owns the motion, so the twin teleports without sweeping, which also skips the physics velocity update
+        Twin->SetWorldTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+        return true;
+    }
+
+    // A VHL input set while the mechanism is loading is applied once it is loaded, see UVortexSettings::EnableAsynchronousMechanismLoading.
+    // In pipelined simulation mode, a VHL input set while a step is running on the simulation thread is applied at the next step boundary
+    template <typename ValueType>
+    bool DeferUntilStepBoundary(UMechanismComponent* Component, void (UMechanismComponent::*Setter)(FString, FString, ValueType), const FString& VHLName, const FString& FieldName, ValueType Value)
+    {
+        TWeakObjectPtr<UMechanismComponent> WeakComponent(Component);
+        TFunction<void()> Command = [WeakComponent, Setter, VHLName, FieldName, Value]()
+        {
+            if (UMechanismComponent* DeferredComponent = WeakComponent.Get())
+            {
+                (DeferredComponent->*Setter)(VHLName, FieldName, Value);
+            }
+        };
+
+        if (Component->IsMechanismLoadPending())
+        {
+            return Component->DeferUntilMechanismLoaded(MoveTemp(Command));
+        }
+
+        return FVortexRuntimeModule::Get().DeferUntilStepBoundary(MoveTemp(Command));
+    }
+
+    template <typename ValueType>
+    bool DeferUntilStepBoundary(UMechanismComponent* Component, void (UMechanismComponent::*Setter)(const FVortexFieldHandle&, ValueType), const FVortexFieldHandle& Handle, ValueType Value)
+    {
+        TWeakObjectPtr<UMechanismComponent> WeakComponent(Component);
+        return FVortexRuntimeModule::Get().DeferUntilStepBoundary([WeakComponent, Setter, Handle, Value]()
+        {
+            if (UMechanismComponent* DeferredComponent = WeakComponent.Get())
+            {
+                (DeferredComponent->*Setter)(Handle, Value);
+            }
+        });
+    }
+
+    // Returns false if the property type cannot be bound to a VHL field
+    bool GetVHLDataType(const FProperty* Property, EVortexVHLDataType& DataType)
+    {
+        if (Property->ArrayDim != 1)
+        {
+            return false;
+        }
+
+        if (Property->IsA<FBoolProperty>())
+        {
+            DataType = EVortexVHLDataType::Boolean;
+            return true;
+        }
+        if (Property->IsA<FIntProperty>())
+        {
+            DataType = EVortexVHLDataType::Integer;
+            return true;
+        }
+        if (Property->IsA<FFloatProperty>() || Property->IsA<FDoubleProperty>())
+        {
+            DataType = EVortexVHLDataType::Float;
+            return true;
+        }
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            if (StructProperty->Struct == TBaseStructure<FVector2D>::Get())
+            {
+                DataType = EVortexVHLDataType::Vector2;
+                return true;
+            }
+            if (StructProperty->Struct == TBaseStructure<FVector>::Get())
+            {
+                DataType = EVortexVHLDataType::Vector3;
+                return true;
+            }
+            if (StructProperty->Struct == TBaseStructure<FVector4>::Get())
+            {
+                DataType = EVortexVHLDataType::Vector4;
+                return true;
+            }
+            if (StructProperty->Struct == TBaseStructure<FTransform>::Get())
+            {
+                DataType = EVortexVHLDataType::Transform;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Copies the single value read for a subscription into the reported value if it moved by more than Epsilon since the last report
+    bool UpdateReportedVHLValue(EVortexVHLDataType DataType, const FVortexVHLBatchValues& Value, float Epsilon, FVortexVHLValue& Reported)
+    {
+        switch (DataType)
+        {
+        case EVortexVHLDataType::Boolean:
+            if (Value.Booleans[0] == Reported.Boolean)
+            {
+                return false;
+            }
+            Reported.Boolean = Value.Booleans[0];
+            return true;
+        case EVortexVHLDataType::Integer:
+            if (Value.Integers[0] == Reported.Integer)
+            {
+                return false;
+            }
+            Reported.Integer = Value.Integers[0];
+            return true;
+        case EVortexVHLDataType::Float:
+            if (FMath::Abs(Value.Floats[0] - Reported.Float) <= Epsilon)
+            {
+                return false;
+            }
+            Reported.Float = Value.Floats[0];
+            return true;
+        case EVortexVHLDataType::Vector2:
+            if (Value.Vectors2[0].Equals(Reported.Vector2, Epsilon))
+            {
+                return false;
+            }
+            Reported.Vector2 = Value.Vectors2[0];
+            return true;
+        case EVortexVHLDataType::Vector3:
+            if (Value.Vectors3[0].Equals(Reported.Vector3, Epsilon))
+            {
+                return false;
+            }
+            Reported.Vector3 = Value.Vectors3[0];
+            return true;
+        case EVortexVHLDataType::Vector4:
+            if (Value.Vectors4[0].Equals(Reported.Vector4, Epsilon))
+            {
+                return false;
+            }
+            Reported.Vector4 = Value.Vectors4[0];
+            return true;
+        case EVortexVHLDataType::Transform:
+            if (Value.Transforms[0].Equals(Reported.Transform, Epsilon))
+            {
+                return false;
+            }
+            Reported.Transform = Value.Transforms[0];
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void CopyAsUTF8(const FString& Name, TArray<ANSICHAR>& OutName)
+    {
+        FTCHARToUTF8 Converted(*Name);
+        OutName.Reset(Converted.Length() + 1);
+        OutName.Append(Converted.Get(), Converted.Length());
+        OutName.Add('\0');
+    }
+}
 
 // Sets default values for this component's properties
 UMechanismComponent::UMechanismComponent()
     : UActorComponent()
+    , bUseInstancedRendering(false)
     , VortexObject(nullptr)
+    , bMechanismLoadPending(false)
+    , bGraphicNodeTwinsSynced(false)
+    , CompiledMappingsGeneration(0)
+    , bComponentMappingsDirty(true)
+    , VisualUpdateInterval(1)
+    , FramesUntilVisualUpdate(0)
+    , CurrentStepOutputs(0)
+    , CapturedStepCount(0)
+    , FieldHandleGeneration(1)
+    , NextVHLBatchId(0)
+    , NextVHLStructBindingId(0)
+    , NextVHLOutputSubscriptionId(0)
 {
     PrimaryComponentTick.bStartWithTickEnabled = true;
     PrimaryComponentTick.bCanEverTick = true;
@@ -38,12 +234,12 @@ void UMechanismComponent::OnUnregister()
     {
         if (VortexMechanism != nullptr)
         {
-            if (LoadedMechanismKey.IsEmpty())
+            if (!LoadedMechanismKey.IsValid())
             {
-                UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::OnUnregister(): LoadedMechanismKey should not be empty <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
+                UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::OnUnregister(): LoadedMechanismKey should be valid <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
             }
 
-            if (VortexObject == nullptr)
+            if (VortexObject == nullptr && !bMechanismLoadPending)
             {
                 UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::OnUnregister(): The VortexObject should not be NULL <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
             }
@@ -74,8 +270,33 @@ void UMechanismComponent::OnRegister()
 
     // Changing any UProperty causes an ReregisterComponent() via Unreal callbacks.
     // We rely on that to recompute the LoadedMechanismKey when the user picks a VortexMechanism UAsset
+    if (FVortexRuntimeModule::Get().DeferEditorComponent(this))
+        return;
+
+    LoadEditorMechanism();
+}
+
+void UMechanismComponent::LoadEditorMechanism()
+{
     FVortexRuntimeModule::Get().RegisterComponent(this);
 
+    // TickComponent() only sends the owner transform again when it changes
+    if (VortexObject != nullptr && GetOwner() != nullptr)
+    {
+        LastEditorWorldTransform = GetOwner()->GetTransform();
+
+        double translation[3];
+        double rotation[4];
+        VortexIntegrationUtilities::ConvertTransform(LastEditorWorldTransform, translation, rotation);
+        VortexSetWorldTransform(VortexObject, translation, rotation);
+    }
+
+    TArray<FString> TwinNodeNames;
+    FindGraphicNodeTwins(TwinNodeNames);
+}
+
+void UMechanismComponent::FindGraphicNodeTwins(TArray<FString>& TwinNodeNames)
+{
     if (VortexMechanism && VortexMechanism->AutomatedMappingImport)
     {
         // get node count
@@ -113,6 +334,7 @@ void UMechanismComponent::OnRegister()
                 if (auto component = this->GetOwner()->GetDefaultSubobjectByName(nameToUse))
                 {
                     GraphicNodeSceneComponentsTwins.Add(Cast<USceneComponent>(component));
+                    TwinNodeNames.Add(UTF8_TO_TCHAR(nodeData.name));
                 }
             }
         }
@@ -130,6 +352,153 @@ void UMechanismComponent::PostRename(UObject* OldOuter, const FName OldName)
     }
 }
 
+void UMechanismComponent::ApplyGraphicNodeUpdate(int32 TwinIndex, const FVortexGraphicNodeUpdate& Update)
+{
+    if (!GraphicNodeSceneComponentsTwins.IsValidIndex(TwinIndex) || GraphicNodeSceneComponentsTwins[TwinIndex] == nullptr)
+    {
+        return;
+    }
+
+    // Not updating insignificant mechanisms, the twins are read again once the mechanism is significant again
+    if (VisualUpdateInterval <= 0)
+    {
+        return;
+    }
+
+    // Throttled mechanisms move their twins at their next visual update, like the polled ones, see ConsumeVisualUpdate()
+    if (VisualUpdateInterval > 1)
+    {
+        PendingTwinUpdates.SetNum(GraphicNodeSceneComponentsTwins.Num());
+        PendingTwinUpdates[TwinIndex] = { Update.Transform, Update.bVisible, true };
+        return;
+    }
+
+    MoveNotifiedGraphicNodeTwin(TwinIndex, Update.Transform, Update.bVisible);
+}
+
+void UMechanismComponent::MoveNotifiedGraphicNodeTwin(int32 TwinIndex, const FTransform& Transform, bool bVisible)
+{
+    USceneComponent* Twin = GraphicNodeSceneComponentsTwins[TwinIndex];
+
+    // Pushed twins keep the scale read at their last polled sync
+    FTransform TwinTransform = Transform;
+    if (GraphicNodeTwinScales.IsValidIndex(TwinIndex))
+    {
+        TwinTransform.SetScale3D(GraphicNodeTwinScales[TwinIndex]);
+    }
+    MoveGraphicNodeTwin(TwinIndex, TwinTransform);
+    // Instanced twins stay hidden, their instances do not follow the node visibility
+    const bool bInstanced = GraphicNodeInstanceComponents.IsValidIndex(TwinIndex) && GraphicNodeInstanceComponents[TwinIndex] != nullptr;
+    if (!bInstanced && Twin->IsVisible() != bVisible)
+    {
+        Twin->SetVisibility(bVisible);
+    }
+}
+
+void UMechanismComponent::ApplyPendingTwinUpdates()
+{
+    for (int32 i = 0; i < PendingTwinUpdates.Num(); ++i)
+    {
+        FMechanismPendingTwinUpdate& Pending = PendingTwinUpdates[i];
+        if (Pending.bPending && GraphicNodeSceneComponentsTwins.IsValidIndex(i) && GraphicNodeSceneComponentsTwins[i] != nullptr)
+        {
+            MoveNotifiedGraphicNodeTwin(i, Pending.Transform, Pending.bVisible);
+        }
+        Pending.bPending = false;
+    }
+}
+
+#if WITH_EDITOR
+void UMechanismComponent::PostEditChangeProperty(struct FPropertyChangedEvent& e)
+{
+    FName PropertyName = (e.MemberProperty != NULL) ? e.MemberProperty->GetFName() : NAME_None;
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(UMechanismComponent, ComponentMappings))
+    {
+        bComponentMappingsDirty = true;
+    }
+    Super::PostEditChangeProperty(e);
+}
+#endif
+
+void UMechanismComponent::RebuildComponentMappings()
+{
+    CompiledMappings.Reset();
+    bComponentMappingsDirty = true;
+
+    AActor* Actor = GetOwner();
+    if (Actor == nullptr || VortexObject == nullptr || !FVortexRuntimeModule::IsIntegrationLoaded())
+    {
+        return;
+    }
+
+    for (FMechanismComponentMappingSection& section : ComponentMappings)
+    {
+        for (FMechanismComponentMapping& mapping : section.Mappings)
+        {
+            FMechanismCompiledComponentMapping& Compiled = CompiledMappings.AddDefaulted_GetRef();
+            CopyAsUTF8(section.VHLName, Compiled.Handle.InterfaceName);
+            CopyAsUTF8(mapping.TransformFieldName, Compiled.Handle.FieldName);
+            Compiled.Handle.FieldType = EVortexVHLFieldType::Output;
+            Compiled.Handle.DataType = EVortexVHLDataType::Transform;
+            Compiled.Handle.VortexObject = VortexObject;
+            Compiled.Handle.Generation = FieldHandleGeneration;
+
+            USceneComponent* Component = Cast<USceneComponent>(mapping.Component.GetComponent(Actor));
+            Compiled.Component = Component != Actor->GetRootComponent() ? Component : nullptr;
+
+            Compiled.bFieldValid = VortexGetFieldStatus(VortexObject, Compiled.Handle.GetInterfaceName(), Compiled.Handle.GetFieldName(), kVortexFieldTypeOutput, kVortexDataTypeMatrix) == kVortexFieldStatusOK;
+            if (!Compiled.bFieldValid)
+            {
+                LogErrorForVHLFunction("RebuildComponentMappings", VortexMechanism->MechanismFilepath.FilePath, VortexObject, section.VHLName, mapping.TransformFieldName, kVortexFieldTypeOutput, kVortexDataTypeMatrix);
+            }
+        }
+    }
+
+    CompiledMappingsGeneration = FieldHandleGeneration;
+    bComponentMappingsDirty = false;
+}
+
+bool UMechanismComponent::EnsureComponentMappingsCompiled()
+{
+    bool bStale = bComponentMappingsDirty || CompiledMappingsGeneration != FieldHandleGeneration;
+    if (!bStale)
+    {
+        // Mappings can be added or removed at runtime from blueprints
+        int32 MappingCount = 0;
+        for (const FMechanismComponentMappingSection& section : ComponentMappings)
+        {
+            MappingCount += section.Mappings.Num();
+        }
+        bStale = MappingCount != CompiledMappings.Num();
+    }
+
+    if (bStale)
+    {
+        RebuildComponentMappings();
+    }
+
+    return !bComponentMappingsDirty;
+}
+
+void UMechanismComponent::FetchComponentMappingTransforms(FMechanismStepOutputs& Outputs) const
+{
+    Outputs.MappingTransforms.SetNum(CompiledMappings.Num(), false);
+    Outputs.MappingValid.SetNum(CompiledMappings.Num(), false);
+    for (int32 i = 0; i < CompiledMappings.Num(); ++i)
+    {
+        const FMechanismCompiledComponentMapping& Mapping = CompiledMappings[i];
+        bool bValid = false;
+        if (Mapping.bFieldValid)
+        {
+            double Translation[3];
+            double Rotation[4];
+            bValid = VortexGetOutputMatrix(VortexObject, Mapping.Handle.GetInterfaceName(), Mapping.Handle.GetFieldName(), Translation, Rotation);
+            Outputs.MappingTransforms[i] = bValid ? VortexIntegrationUtilities::ConvertTransform(Translation, Rotation) : FTransform::Identity;
+        }
+        Outputs.MappingValid[i] = bValid;
+    }
+}
+
 void UMechanismComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     UActorComponent::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -137,6 +506,8 @@ void UMechanismComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
         return;
 
+    FVortexRuntimeModule::Get().WaitForSimulationStep();
+
     if (AActor * Actor = GetOwner())
     {
         if (UWorld * World = GetWorld())
@@ -144,11 +515,13 @@ void UMechanismComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
             // Editor Components Only
             if (!HasBegunPlay() && World->WorldType.GetValue() == EWorldType::Editor)
             {
-                if (VortexObject != nullptr)
+                if (VortexObject != nullptr && !Actor->GetTransform().Equals(LastEditorWorldTransform))
                 {
+                    LastEditorWorldTransform = Actor->GetTransform();
+
                     double translation[3];
                     double rotation[4];
-                    VortexIntegrationUtilities::ConvertTransform(Actor->GetTransform(), translation, rotation);
+                    VortexIntegrationUtilities::ConvertTransform(LastEditorWorldTransform, translation, rotation);
                     VortexSetWorldTransform(VortexObject, translation, rotation);
                 }
             }
@@ -169,166 +542,537 @@ void UMechanismComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
                         }
                     }
 #endif
-                    for (int i = 0; i < GraphicNodeSceneComponentsTwins.Num(); ++i)
+                    // In batch mode, visuals are only synchronized once in a while
+                    const FVortexRuntimeModule& RuntimeModule = FVortexRuntimeModule::Get();
+                    if (HasBegunPlay() && !RuntimeModule.ShouldSyncVisuals())
                     {
-                        double translation[3] = {};
-                        double scale[3] = {};
-                        double rotation[4] = {};
-                        VortexGetParentTransform(GraphicNodeObjectHandles[i], translation, scale, rotation);
-
-                        GraphicNodeSceneComponentsTwins[i]->SetWorldScale3D(FVector(scale[0], scale[1], scale[2]));
-                        GraphicNodeSceneComponentsTwins[i]->SetWorldLocation(VortexIntegrationUtilities::ConvertTranslation(translation));
-                        GraphicNodeSceneComponentsTwins[i]->SetWorldRotation(VortexIntegrationUtilities::ConvertRotation(rotation));
+                        return;
                     }
-                    
-                    for (FMechanismComponentMappingSection& section : ComponentMappings)
+
+                    if (HasBegunPlay() && !ConsumeVisualUpdate())
                     {
-                        for (FMechanismComponentMapping& mapping : section.Mappings)
-                        {
-                            if (USceneComponent * Component = Cast<USceneComponent>(mapping.Component.GetComponent(Actor)))
-                            {
-                                if (Component != Actor->GetRootComponent())
-                                {
-                                    double Translation[3];
-                                    double Rotation[4];
-                                    if (VortexGetOutputMatrix(VortexObject, TCHAR_TO_UTF8(*section.VHLName), TCHAR_TO_UTF8(*mapping.TransformFieldName), Translation, Rotation))
-                                    {
-                                        FTransform transform = VortexIntegrationUtilities::ConvertTransform(Translation, Rotation);
-                                        Component->SetWorldTransform(transform);
-                                    }
-                                    else
-                                    {
-                                        LogErrorForVHLFunction("TickComponent", VortexMechanism->MechanismFilepath.FilePath, VortexObject, section.VHLName, mapping.TransformFieldName, kVortexFieldTypeOutput, kVortexDataTypeMatrix);
-                                    }
-                                }
-                            }
-                        }
+                        return;
                     }
+
+                    SyncSceneComponents(RuntimeModule);
                 }
             }
         }
     }
 }
 
-void UMechanismComponent::BeginPlay()
+bool UMechanismComponent::ConsumeVisualUpdate()
 {
-    Super::BeginPlay();
-
-    FVortexRuntimeModule::Get().RegisterComponent(this);
-    FVortexRuntimeModule::Get().BeginPlay(this);
+    if (VisualUpdateInterval <= 0)
+    {
+        return false;
+    }
 
-    if (VortexMechanism != nullptr)
+    if (FramesUntilVisualUpdate > 0)
     {
-        if (LoadedMechanismKey.IsEmpty())
-        {
-            UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::BeginPlay(): LoadedMechanismKey should not be empty <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
-        }
+        --FramesUntilVisualUpdate;
+        return false;
+    }
 
-        if (VortexObject == nullptr)
-        {
-            UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::BeginPlay(): The VortexObject should not be NULL <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
-        }
+    FramesUntilVisualUpdate = VisualUpdateInterval - 1;
+    return true;
+}
 
-        if (VortexMechanism && VortexMechanism->AutomatedMappingImport)
-        {
-            // get node count
-            std::uint32_t MaterialNodeCount = 0;
-            VortexGetGraphicsNodeHandles(VortexObject, nullptr, &MaterialNodeCount);
-            // get node handles
-            std::vector<VortexObjectHandle> GraphicsNodeArray(MaterialNodeCount, nullptr);
-            VortexGetGraphicsNodeHandles(VortexObject, GraphicsNodeArray.data(), &MaterialNodeCount);
+void UMechanismComponent::SetVisualUpdateInterval(int32 Interval)
+{
+    if (Interval == VisualUpdateInterval)
+    {
+        return;
+    }
 
-            for (VortexObjectHandle node : GraphicsNodeArray)
-            {
-                VortexGraphicNodeData nodeData = {};
-                VortexGetGraphicNodeData(node, &nodeData);
+    if (Interval <= 0)
+    {
+        // Node notifications are dropped while not updating, so all the twins are read again on the next update
+        bGraphicNodeTwinsSynced = false;
+        PendingTwinUpdates.Empty();
+    }
 
-                if (nodeData.hasConnection)
-                {
-                    GraphicNodeObjectHandles.Add(node);
+    // A mechanism becoming more significant is updated right away
+    FramesUntilVisualUpdate = VisualUpdateInterval <= 0 ? 0 : FMath::Min(FramesUntilVisualUpdate, FMath::Max(0, Interval - 1));
+    VisualUpdateInterval = Interval;
+}
 
-                    //Don't use directly name from nodeData as it might have been renamed in Vortex, use the lookup table first using the ContentID
-                    //If the mapping is not found (happens with legacy MechanismComponent), just use noData.name directly
-                    FName nameToUse(nodeData.name);
-                    for (const FMechanismGraphicNodeMapping& mapping : VortexMechanism->GraphicNodeMappings)
-                    {
-                        //if we have an existing mapping for this node, use the name from the mapping
-                        uint64 mappingContentID[2] = { ((uint64)mapping.ContentID.id00 & 0xFFFFFFFF) | ((uint64)mapping.ContentID.id01) << 32,
-                                                       ((uint64)mapping.ContentID.id10 & 0xFFFFFFFF) | ((uint64)mapping.ContentID.id11) << 32 };
-                        if (mappingContentID[0] == nodeData.contentID[0] && mappingContentID[1] == nodeData.contentID[1])
-                        {
-                            //update the name in case it has changed
-                            nameToUse = mapping.GraphicsNodeName;
-                            break;
-                        }
-                    }
+FBox UMechanismComponent::GetGraphicNodeInstanceBounds() const
+{
+    FBox Bounds(ForceInit);
+    if (!Instancer.IsValid())
+    {
+        return Bounds;
+    }
 
-                    if (auto component = this->GetOwner()->GetDefaultSubobjectByName(nameToUse))
-                    {
-                        GraphicNodeSceneComponentsTwins.Add(Cast<USceneComponent>(component));
-                    }
-                }
-            }
+    for (int32 i = 0; i < GraphicNodeInstanceComponents.Num(); ++i)
+    {
+        const UHierarchicalInstancedStaticMeshComponent* Instances = GraphicNodeInstanceComponents[i];
+        FTransform InstanceTransform;
+        if (Instances != nullptr && Instances->GetStaticMesh() != nullptr && Instances->GetInstanceTransform(GraphicNodeInstanceIndices[i], InstanceTransform, true))
+        {
+            Bounds += Instances->GetStaticMesh()->GetBounds().GetBox().TransformBy(InstanceTransform);
         }
     }
+    return Bounds;
 }
 
-void UMechanismComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+void UMechanismComponent::SyncSceneComponents(const FVortexRuntimeModule& RuntimeModule)
 {
-    if (IsRegistered())
+    GatherSceneTransforms(RuntimeModule);
+    ConvertSceneTransforms();
+    ApplySceneTransforms();
+}
+
+void UMechanismComponent::GatherSceneTransforms(const FVortexRuntimeModule& RuntimeModule)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GatherSceneTransforms);
+    using ESource = FMechanismSceneSync::ESource;
+    constexpr int32 Stride = FMechanismSceneSync::PoseStride;
+
+    // Blend the last two steps when interpolating, fall back to the latest Vortex state otherwise
+    const bool bInterpolate = HasBegunPlay() && CapturedStepCount >= 2 && RuntimeModule.IsInterpolatingTransforms();
+    const FMechanismStepOutputs& PreviousOutputs = StepOutputs[1 - CurrentStepOutputs];
+    const FMechanismStepOutputs& CurrentOutputs = StepOutputs[CurrentStepOutputs];
+
+    // Once synchronized, twins of notified nodes are only moved by ApplyGraphicNodeUpdate()
+    const bool bSkipPushedTwins = HasBegunPlay() && bGraphicNodeTwinsSynced && RuntimeModule.IsPushingGraphicNodes();
+    bGraphicNodeTwinsSynced = HasBegunPlay();
+
+    const int32 MappingCount = EnsureComponentMappingsCompiled() ? CompiledMappings.Num() : 0;
+    const int32 TwinCount = GraphicNodeSceneComponentsTwins.Num();
+    const int32 Count = TwinCount + MappingCount;
+
+    FMechanismSceneSync& Sync = SceneSync;
+    Sync.TwinCount = TwinCount;
+    Sync.Alpha = bInterpolate ? RuntimeModule.GetInterpolationAlpha() : 1.0f;
+    Sync.Sources.SetNumUninitialized(Count, false);
+    Sync.TwinTranslations.SetNumUninitialized(TwinCount * 3, false);
+    Sync.TwinScales.SetNumUninitialized(TwinCount * 3, false);
+    Sync.TwinRotations.SetNumUninitialized(TwinCount * 4, false);
+    Sync.VortexPoses.SetNumUninitialized(MappingCount * Stride, false);
+    Sync.Transforms.SetNumUninitialized(Count, false);
+
+    for (int32 i = 0; i < TwinCount; ++i)
+    {
+        if (bSkipPushedTwins && GraphicNodeTwinsPushed.IsValidIndex(i) && GraphicNodeTwinsPushed[i])
+        {
+            Sync.Sources[i] = ESource::None;
+        }
+        else if (bInterpolate && PreviousOutputs.GraphicNodeTransforms.IsValidIndex(i) && CurrentOutputs.GraphicNodeTransforms.IsValidIndex(i))
+        {
+            Sync.Sources[i] = ESource::Blend;
+        }
+        else
+        {
+            VortexGetParentTransform(GraphicNodeObjectHandles[i], &Sync.TwinTranslations[i * 3], &Sync.TwinScales[i * 3], &Sync.TwinRotations[i * 4]);
+            Sync.Sources[i] = ESource::Vortex;
+        }
+    }
+
+    for (int32 Index = 0; Index < MappingCount; ++Index)
     {
-        FVortexRuntimeModule::Get().EndPlay(this);
-        if (VortexMechanism != nullptr)
+        const int32 Entry = TwinCount + Index;
+        const FMechanismCompiledComponentMapping& Mapping = CompiledMappings[Index];
+        if (!Mapping.Component.IsValid() || !Mapping.bFieldValid)
+        {
+            Sync.Sources[Entry] = ESource::None;
+        }
+        else if (bInterpolate && PreviousOutputs.MappingValid.IsValidIndex(Index) && CurrentOutputs.MappingValid.IsValidIndex(Index)
+            && PreviousOutputs.MappingValid[Index] && CurrentOutputs.MappingValid[Index])
+        {
+            Sync.Sources[Entry] = ESource::Blend;
+        }
+        else
         {
-            if (LoadedMechanismKey.IsEmpty())
+            double* Pose = &Sync.VortexPoses[Index * Stride];
+            if (VortexGetOutputMatrix(VortexObject, Mapping.Handle.GetInterfaceName(), Mapping.Handle.GetFieldName(), Pose, Pose + 6))
             {
-                UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::EndPlay(): LoadedMechanismKey should not be empty <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
+                Sync.Sources[Entry] = ESource::Vortex;
             }
-
-            if (VortexObject == nullptr)
+            else
             {
-                UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::EndPlay(): The VortexObject should not be NULL <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
+                LogErrorForVHLFieldHandle(TEXT("GatherSceneTransforms"), Mapping.Handle);
+                Sync.Sources[Entry] = ESource::None;
             }
         }
-
-        FVortexRuntimeModule::Get().UnregisterAllComponents(LoadedMechanismKey);
     }
-
-    Super::EndPlay(EndPlayReason);
 }
 
-void UMechanismComponent::onComponentUnregistered()
+void UMechanismComponent::ConvertSceneTransforms()
 {
-    GraphicNodeObjectHandles.Empty();
-    GraphicNodeSceneComponentsTwins.Empty();
-}
+    using ESource = FMechanismSceneSync::ESource;
+    constexpr int32 Stride = FMechanismSceneSync::PoseStride;
 
-void UMechanismComponent::GetVHLFieldAsBool(FString VHLName, FString FieldName, bool& bValue)
-{
-    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
-    if (!FVortexRuntimeModule::IsIntegrationLoaded())
-        return;
+    FMechanismSceneSync& Sync = SceneSync;
+    const FMechanismStepOutputs& PreviousOutputs = StepOutputs[1 - CurrentStepOutputs];
+    const FMechanismStepOutputs& CurrentOutputs = StepOutputs[CurrentStepOutputs];
 
-    if (!PreValidateVHLFunction("GetVHLFieldAsBool", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
+    // Consecutive twins read from Vortex are converted in one call
+    int32 RunStart = INDEX_NONE;
+    for (int32 Entry = 0; Entry <= Sync.TwinCount; ++Entry)
     {
-        return;
+        const bool bVortex = Entry < Sync.TwinCount && Sync.Sources[Entry] == ESource::Vortex;
+        if (bVortex && RunStart == INDEX_NONE)
+        {
+            RunStart = Entry;
+        }
+        else if (!bVortex && RunStart != INDEX_NONE)
+        {
+            VortexIntegrationUtilities::ConvertTransforms(&Sync.TwinTranslations[RunStart * 3], &Sync.TwinScales[RunStart * 3], &Sync.TwinRotations[RunStart * 4], Entry - RunStart, &Sync.Transforms[RunStart]);
+            RunStart = INDEX_NONE;
+        }
+
+        if (Entry < Sync.TwinCount && Sync.Sources[Entry] == ESource::Blend)
+        {
+            Sync.Transforms[Entry].Blend(PreviousOutputs.GraphicNodeTransforms[Entry], CurrentOutputs.GraphicNodeTransforms[Entry], Sync.Alpha);
+        }
     }
 
-    if (!VortexGetOutputBoolean(VortexObject, TCHAR_TO_UTF8(*VHLName), TCHAR_TO_UTF8(*FieldName), &bValue))
+    for (int32 Entry = Sync.TwinCount; Entry < Sync.Sources.Num(); ++Entry)
     {
-        LogErrorForVHLFunction("GetVHLFieldAsBool", VortexMechanism->MechanismFilepath.FilePath, VortexObject, VHLName, FieldName, kVortexFieldTypeOutput, kVortexDataTypeBoolean);
+        const int32 Index = Entry - Sync.TwinCount;
+        if (Sync.Sources[Entry] == ESource::Blend)
+        {
+            Sync.Transforms[Entry].Blend(PreviousOutputs.MappingTransforms[Index], CurrentOutputs.MappingTransforms[Index], Sync.Alpha);
+        }
+        else if (Sync.Sources[Entry] == ESource::Vortex)
+        {
+            Sync.Transforms[Entry] = VortexIntegrationUtilities::ConvertTransform(&Sync.VortexPoses[Index * Stride], &Sync.VortexPoses[Index * Stride + 6]);
+        }
     }
 }
 
-void UMechanismComponent::SetVHLFieldAsBool(FString VHLName, FString FieldName, bool bValue)
+void UMechanismComponent::ApplySceneTransforms()
 {
-    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
-    if (!FVortexRuntimeModule::IsIntegrationLoaded())
-        return;
+    SCOPE_CYCLE_COUNTER(STAT_ApplySceneTransforms);
+    using ESource = FMechanismSceneSync::ESource;
 
-    if (!PreValidateVHLFunction("SetVHLFieldAsBool", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
+    const FMechanismSceneSync& Sync = SceneSync;
+    int32 SkippedGraphicNodes = 0;
+    for (int32 Entry = 0; Entry < Sync.Sources.Num(); ++Entry)
     {
-        return;
+        if (Sync.Sources[Entry] == ESource::None)
+        {
+            continue;
+        }
+
+        if (Entry < Sync.TwinCount)
+        {
+            GraphicNodeTwinScales.SetNum(Sync.TwinCount);
+            GraphicNodeTwinScales[Entry] = Sync.Transforms[Entry].GetScale3D();
+            if (!MoveGraphicNodeTwin(Entry, Sync.Transforms[Entry]))
+            {
+                ++SkippedGraphicNodes;
+            }
+        }
+        else if (USceneComponent* Component = CompiledMappings[Entry - Sync.TwinCount].Component.Get())
+        {
+            Component->SetWorldTransform(Sync.Transforms[Entry]);
+        }
+    }
+    INC_DWORD_STAT_BY(STAT_SkippedGraphicNodes, SkippedGraphicNodes);
+
+    // Notified twins waiting for this visual update
+    ApplyPendingTwinUpdates();
+}
+
+void UMechanismComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    FVortexRuntimeModule::Get().RegisterComponent(this);
+
+    // The runtime module synchronizes all the playing components in one loop instead
+    if (FVortexRuntimeModule::Get().IsTickingComponentsCentrally())
+    {
+        SetComponentTickEnabled(false);
+    }
+
+    // Otherwise the runtime module completes the load once it loaded the mechanism
+    if (!bMechanismLoadPending)
+    {
+        OnMechanismLoadCompleted();
+    }
+}
+
+void UMechanismComponent::OnMechanismLoadCompleted()
+{
+    bMechanismLoadPending = false;
+    FVortexRuntimeModule::Get().BeginPlay(this);
+
+    if (VortexMechanism != nullptr)
+    {
+        if (!LoadedMechanismKey.IsValid())
+        {
+            UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::BeginPlay(): LoadedMechanismKey should be valid <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
+        }
+
+        if (VortexObject == nullptr)
+        {
+            UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::BeginPlay(): The VortexObject should not be NULL <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
+        }
+
+        TArray<FString> TwinNodeNames;
+        FindGraphicNodeTwins(TwinNodeNames);
+        FVortexRuntimeModule::Get().BindGraphicNodeTwins(this, TwinNodeNames, GraphicNodeTwinsPushed);
+        RebuildComponentMappings();
+
+        if (bUseInstancedRendering)
+        {
+            AddGraphicNodeInstances();
+        }
+    }
+
+    // Completing the load runs the VHL calls made while it was pending, which can unregister the component
+    TArray<TFunction<void()>> Commands = MoveTemp(MechanismLoadCommands);
+    MechanismLoadCommands.Reset();
+    for (auto& Command : Commands)
+    {
+        Command();
+    }
+
+    OnMechanismLoaded.Broadcast(this);
+}
+
+bool UMechanismComponent::DeferUntilMechanismLoaded(TFunction<void()>&& Command)
+{
+    if (!bMechanismLoadPending)
+    {
+        return false;
+    }
+
+    MechanismLoadCommands.Add(MoveTemp(Command));
+    return true;
+}
+
+void UMechanismComponent::AddGraphicNodeInstances()
+{
+    AVortexMechanismInstancer* WorldInstancer = AVortexMechanismInstancer::Get(GetWorld());
+    if (WorldInstancer == nullptr)
+    {
+        UE_LOG(LogVortex, Warning, TEXT("UMechanismComponent::AddGraphicNodeInstances(): Could not spawn the instancer, the graphic node twins of <%s> are rendered individually."), *GetOwner()->GetName());
+        return;
+    }
+
+    Instancer = WorldInstancer;
+    GraphicNodeInstanceComponents.Init(nullptr, GraphicNodeSceneComponentsTwins.Num());
+    GraphicNodeInstanceIndices.Init(INDEX_NONE, GraphicNodeSceneComponentsTwins.Num());
+    for (int32 i = 0; i < GraphicNodeSceneComponentsTwins.Num(); ++i)
+    {
+        UStaticMeshComponent* Twin = Cast<UStaticMeshComponent>(GraphicNodeSceneComponentsTwins[i]);
+        if (!AVortexMechanismInstancer::CanInstance(Twin))
+        {
+            continue;
+        }
+
+        GraphicNodeInstanceComponents[i] = WorldInstancer->AddInstance(Twin, this, i, GraphicNodeInstanceIndices[i]);
+
+        // The instance renders the twin from now on
+        Twin->SetVisibility(false);
+        Twin->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+}
+
+void UMechanismComponent::RemoveGraphicNodeInstances()
+{
+    if (AVortexMechanismInstancer* WorldInstancer = Instancer.Get())
+    {
+        for (int32 i = 0; i < GraphicNodeInstanceComponents.Num(); ++i)
+        {
+            if (GraphicNodeInstanceComponents[i] != nullptr)
+            {
+                WorldInstancer->RemoveInstance(GraphicNodeInstanceComponents[i], GraphicNodeInstanceIndices[i]);
+            }
+        }
+    }
+
+    Instancer.Reset();
+    GraphicNodeInstanceComponents.Empty();
+    GraphicNodeInstanceIndices.Empty();
+}
+
+bool UMechanismComponent::MoveGraphicNodeTwin(int32 TwinIndex, const FTransform& Transform)
+{
+    if (GraphicNodeInstanceComponents.IsValidIndex(TwinIndex) && GraphicNodeInstanceComponents[TwinIndex] != nullptr)
+    {
+        AVortexMechanismInstancer* WorldInstancer = Instancer.Get();
+        return WorldInstancer != nullptr && WorldInstancer->SetInstanceTransform(GraphicNodeInstanceComponents[TwinIndex], GraphicNodeInstanceIndices[TwinIndex], Transform, GraphicNodeTransformTolerance);
+    }
+
+    return SyncGraphicNodeTwin(GraphicNodeSceneComponentsTwins[TwinIndex], Transform);
+}
+
+void UMechanismComponent::OnGraphicNodeInstanceMoved(int32 TwinIndex, int32 Index)
+{
+    if (GraphicNodeInstanceIndices.IsValidIndex(TwinIndex))
+    {
+        GraphicNodeInstanceIndices[TwinIndex] = Index;
+    }
+}
+
+void UMechanismComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (IsRegistered())
+    {
+        FVortexRuntimeModule::Get().EndPlay(this, EndPlayReason);
+        if (VortexMechanism != nullptr)
+        {
+            if (!LoadedMechanismKey.IsValid())
+            {
+                UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::EndPlay(): LoadedMechanismKey should be valid <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
+            }
+
+            if (VortexObject == nullptr && !bMechanismLoadPending)
+            {
+                UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::EndPlay(): The VortexObject should not be NULL <%s>."), *VortexMechanism->MechanismFilepath.FilePath);
+            }
+        }
+
+        // The mechanism of a streamed level being unloaded stays in the pool for a while, see UVortexSettings::MechanismPoolLifetime,
+        // and so does the mechanism of a play in editor session ending with UVortexSettings::EnableWarmPlayInEditorRestart
+        FVortexRuntimeModule::Get().UnregisterAllComponents(LoadedMechanismKey, !FVortexRuntimeModule::Get().ShouldPoolMechanismOnEndPlay(EndPlayReason));
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UMechanismComponent::onComponentUnregistered()
+{
+    bMechanismLoadPending = false;
+    MechanismLoadCommands.Empty();
+    RemoveGraphicNodeInstances();
+    GraphicNodeObjectHandles.Empty();
+    GraphicNodeSceneComponentsTwins.Empty();
+    GraphicNodeTwinsPushed.Empty();
+    bGraphicNodeTwinsSynced = false;
+    GraphicNodeTwinScales.Empty();
+    PendingTwinUpdates.Empty();
+    VisualUpdateInterval = 1;
+    FramesUntilVisualUpdate = 0;
+    CapturedStepCount = 0;
+    CompiledMappings.Empty();
+    bComponentMappingsDirty = true;
+    QueuedInputTracks.Empty();
+    ++FieldHandleGeneration;
+    VHLBatches.Empty();
+    VHLStructBindings.Empty();
+    VHLOutputSubscriptions.Empty();
+
+    if (InputCommandQueue.IsValid())
+    {
+        InputCommandQueue->Unbind();
+        InputCommandQueue.Reset();
+    }
+
+    for (const FVortexOutputSnapshotChannelPtr& Channel : OutputSnapshotChannels)
+    {
+        Channel->Unbind();
+    }
+    OutputSnapshotChannels.Empty();
+}
+
+FVortexInputCommandQueuePtr UMechanismComponent::GetInputCommandQueue()
+{
+    check(IsInGameThread());
+
+    // The queue only accepts the handles of the mechanism loaded when it was created, such as after an asynchronous load
+    if (InputCommandQueue.IsValid() && (InputCommandQueue->VortexObject != VortexObject || InputCommandQueue->Generation != FieldHandleGeneration))
+    {
+        InputCommandQueue->Unbind();
+        InputCommandQueue.Reset();
+    }
+
+    if (!InputCommandQueue.IsValid())
+    {
+        InputCommandQueue = MakeShared<FVortexInputCommandQueue, ESPMode::ThreadSafe>(VortexObject, FieldHandleGeneration);
+    }
+
+    return InputCommandQueue;
+}
+
+FVortexOutputSnapshotChannelPtr UMechanismComponent::SubscribeOutputSnapshots(const TArray<FVortexFieldHandle>& Outputs, bool bIncludeGraphicNodes)
+{
+    check(IsInGameThread());
+    for (const FVortexFieldHandle& Handle : Outputs)
+    {
+        if (!PreValidateVHLFieldHandle(TEXT("SubscribeOutputSnapshots"), Handle, EVortexVHLFieldType::Output, Handle.DataType))
+        {
+            return nullptr;
+        }
+    }
+
+    FVortexOutputSnapshotChannelPtr Channel = MakeShared<FVortexOutputSnapshotChannel, ESPMode::ThreadSafe>(Outputs, bIncludeGraphicNodes ? GraphicNodeObjectHandles : TArray<VortexObjectHandle>());
+    OutputSnapshotChannels.Add(Channel);
+
+    return Channel;
+}
+
+void UMechanismComponent::CaptureStepOutputs()
+{
+    if (VortexObject == nullptr || !HasBegunPlay())
+    {
+        return;
+    }
+
+    CurrentStepOutputs = 1 - CurrentStepOutputs;
+    FMechanismStepOutputs& Outputs = StepOutputs[CurrentStepOutputs];
+
+    // Read all the nodes, then convert them in one pass
+    const int32 NodeCount = GraphicNodeSceneComponentsTwins.Num();
+    TArray<double, TInlineAllocator<64 * 10>> Poses;
+    Poses.SetNumZeroed(NodeCount * 10);
+    double* Translations = Poses.GetData();
+    double* Scales = Translations + NodeCount * 3;
+    double* Rotations = Scales + NodeCount * 3;
+    for (int i = 0; i < NodeCount; ++i)
+    {
+        VortexGetParentTransform(GraphicNodeObjectHandles[i], Translations + i * 3, Scales + i * 3, Rotations + i * 4);
+    }
+
+    Outputs.GraphicNodeTransforms.SetNum(NodeCount, false);
+    VortexIntegrationUtilities::ConvertTransforms(Translations, Scales, Rotations, NodeCount, Outputs.GraphicNodeTransforms.GetData());
+
+    // Errors are reported by TickComponent(), which falls back to reading an invalid mapping directly
+    if (EnsureComponentMappingsCompiled())
+    {
+        FetchComponentMappingTransforms(Outputs);
+    }
+
+    CapturedStepCount = FMath::Min(CapturedStepCount + 1, 2);
+}
+
+void UMechanismComponent::GetVHLFieldAsBool(FString VHLName, FString FieldName, bool& bValue)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+        return;
+
+    if (!PreValidateVHLFunction("GetVHLFieldAsBool", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
+    {
+        return;
+    }
+
+    if (!VortexGetOutputBoolean(VortexObject, TCHAR_TO_UTF8(*VHLName), TCHAR_TO_UTF8(*FieldName), &bValue))
+    {
+        LogErrorForVHLFunction("GetVHLFieldAsBool", VortexMechanism->MechanismFilepath.FilePath, VortexObject, VHLName, FieldName, kVortexFieldTypeOutput, kVortexDataTypeBoolean);
+    }
+}
+
+void UMechanismComponent::SetVHLFieldAsBool(FString VHLName, FString FieldName, bool bValue)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+        return;
+
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldAsBool, VHLName, FieldName, bValue))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFunction("SetVHLFieldAsBool", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
+    {
+        return;
     }
     
     if (!VortexSetInputBoolean(VortexObject, TCHAR_TO_UTF8(*VHLName), TCHAR_TO_UTF8(*FieldName), bValue))
@@ -360,6 +1104,11 @@ void UMechanismComponent::SetVHLFieldAsInteger(FString VHLName, FString FieldNam
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
         return;
 
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldAsInteger, VHLName, FieldName, Value))
+    {
+        return;
+    }
+
     if (!PreValidateVHLFunction("SetVHLFieldAsInteger", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
     {
         return;
@@ -399,6 +1148,11 @@ void UMechanismComponent::SetVHLFieldAsFloat(FString VHLName, FString FieldName,
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
         return;
 
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldAsFloat, VHLName, FieldName, Value))
+    {
+        return;
+    }
+
     if (!PreValidateVHLFunction("SetVHLFieldAsFloat", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
     {
         return;
@@ -440,6 +1194,11 @@ void UMechanismComponent::SetVHLFieldAsVector2(FString VHLName, FString FieldNam
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
         return;
 
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldAsVector2, VHLName, FieldName, Value))
+    {
+        return;
+    }
+
     if (!PreValidateVHLFunction("SetVHLFieldAsVector2", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
     {
         return;
@@ -482,6 +1241,11 @@ void UMechanismComponent::SetVHLFieldAsVector3(FString VHLName, FString FieldNam
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
         return;
 
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldAsVector3, VHLName, FieldName, Value))
+    {
+        return;
+    }
+
     if (!PreValidateVHLFunction("SetVHLFieldAsVector3", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
     {
         return;
@@ -525,6 +1289,11 @@ void UMechanismComponent::SetVHLFieldAsVector4(FString VHLName, FString FieldNam
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
         return;
 
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldAsVector4, VHLName, FieldName, Value))
+    {
+        return;
+    }
+
     if (!PreValidateVHLFunction("SetVHLFieldAsVector4", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
     {
         return;
@@ -573,6 +1342,11 @@ void UMechanismComponent::SetVHLFieldAsString(FString VHLName, FString FieldName
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
         return;
 
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldAsString, VHLName, FieldName, Value))
+    {
+        return;
+    }
+
     if (!PreValidateVHLFunction("SetVHLFieldAsString", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
     {
         return;
@@ -614,6 +1388,11 @@ void UMechanismComponent::SetVHLFieldAsTransform(FString VHLName, FString FieldN
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
         return;
 
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldAsTransform, VHLName, FieldName, Transform))
+    {
+        return;
+    }
+
     if (!PreValidateVHLFunction("SetVHLFieldAsTransform", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
     {
         return;
@@ -689,20 +1468,23 @@ void UMechanismComponent::GetVHLFieldAsHeightField(FString VHLName, FString Fiel
             double halfWidth = 0.5 * HeightField.cellSizeX * (HeightField.nbVerticesX - 1);
             double halfHeight = 0.5 * HeightField.cellSizeY * (HeightField.nbVerticesY - 1);
 
-            Vertices.SetNum(VertexCount);
+            // Vertices are laid out in Vortex conventions first, then converted together
+            TArray<double> VortexVertices;
+            VortexVertices.SetNumUninitialized(VertexCount * 3);
+            Vertices.SetNumUninitialized(VertexCount);
             UV0.SetNum(VertexCount);
             for (std::uint32_t y = 0, i = 0; y < HeightField.nbVerticesY; ++y)
             {
                 for (std::uint32_t x = 0; x < HeightField.nbVerticesX; ++x)
                 {
-                    double pos[3] = {
-                        HeightField.cellSizeX * x - halfWidth,
-                        HeightField.cellSizeY * y - halfHeight,
-                        HeightField.heights[IndexOf(x, y)] };
-                    Vertices[i] = VortexIntegrationUtilities::ConvertTranslation(pos);
+                    double* pos = &VortexVertices[i * 3];
+                    pos[0] = HeightField.cellSizeX * x - halfWidth;
+                    pos[1] = HeightField.cellSizeY * y - halfHeight;
+                    pos[2] = HeightField.heights[IndexOf(x, y)];
                     UV0[i++] = FVector2D(pos[0], pos[1]);
                 }
             }
+            VortexIntegrationUtilities::ConvertTranslations(VortexVertices.GetData(), VertexCount, Vertices.GetData());
 
             // calculate smooth normals
             Normals.SetNum(VertexCount);
@@ -831,6 +1613,8 @@ void UMechanismComponent::GetVHLFieldAsTiledHeightField(FString VHLName, FString
             return tileX * TileCountY + tileY;
         };
 
+        // Vertices of a section are laid out in Vortex conventions first, then converted together
+        TArray<double> VortexVertices;
         TArray<FVector> Vertices;
         TArray<int32> Triangles;
         TArray<FVector> Normals;
@@ -964,21 +1748,22 @@ void UMechanismComponent::GetVHLFieldAsTiledHeightField(FString VHLName, FString
             };
 
             Colors.SetNum(SectionVertexCount);
-            Vertices.SetNum(SectionVertexCount);
+            VortexVertices.SetNumUninitialized(SectionVertexCount * 3);
+            Vertices.SetNumUninitialized(SectionVertexCount);
             UV0.SetNum(SectionVertexCount);
             for (int32 y = 0, i = 0; y < SectionVerticesY; ++y)
             {
                 for (int32 x = 0; x < SectionVerticesX; ++x)
                 {
-                    double pos[3] = {
-                        TiledHeightField.cellSizeX * x + Tile.tilePositionX,
-                        TiledHeightField.cellSizeY * y + Tile.tilePositionY,
-                        GetHeight(Tile.tileX, Tile.tileY, x, y) };
-                    Vertices[i] = VortexIntegrationUtilities::ConvertTranslation(pos);
+                    double* pos = &VortexVertices[i * 3];
+                    pos[0] = TiledHeightField.cellSizeX * x + Tile.tilePositionX;
+                    pos[1] = TiledHeightField.cellSizeY * y + Tile.tilePositionY;
+                    pos[2] = GetHeight(Tile.tileX, Tile.tileY, x, y);
                     UV0[i] = FVector2D(pos[0], pos[1]);
                     Colors[i++] = GetLandUseID(Tile.tileX, Tile.tileY, x, y) == 0 ? FColor(255, 255, 255) : FColor(0, 0, 0); // color mask to be used by mixing in material
                 }
             }
+            VortexIntegrationUtilities::ConvertTranslations(VortexVertices.GetData(), SectionVertexCount, Vertices.GetData());
 
             // calculate smooth normals
             Normals.SetNum(SectionVertexCount);
@@ -1062,10 +1847,9 @@ void UMechanismComponent::GetVHLFieldAsParticles(FString VHLName, FString FieldN
         Radii.SetNum(particles.count);
         IDs.SetNum(particles.count);
 
+        VortexIntegrationUtilities::ConvertTranslations(particles.positions, particles.count, Positions.GetData());
         for (std::uint32_t i = 0; i < particles.count; ++i)
         {
-            double pos[3] = { particles.positions[i * 3], particles.positions[i * 3 + 1], particles.positions[i * 3 + 2] };
-            Positions[i] = VortexIntegrationUtilities::ConvertTranslation(pos);
             Radii[i] = particles.radii[i];
             IDs[i] = particles.ids[i];
         }
@@ -1128,11 +1912,7 @@ void UMechanismComponent::GetVHLFieldAsGraphicsMesh(FString VHLName, FString Fie
             }
 
             Vertices.SetNum(Vertices.Num() + MeshData.vertexCount);
-            for (std::uint32_t i = 0; i < MeshData.vertexCount; ++i)
-            {
-                double pos[3] = { MeshData.vertices[i * 3], MeshData.vertices[i * 3 + 1], MeshData.vertices[i * 3 + 2] };
-                Vertices[i] = VortexIntegrationUtilities::ConvertTranslation(pos);
-            }
+            VortexIntegrationUtilities::ConvertTranslations(MeshData.vertices, MeshData.vertexCount, Vertices.GetData());
 
             UV0.SetNum(UV0.Num() + MeshData.uvs[0].uvCount);
             for (std::uint32_t i = 0; i < MeshData.uvs[0].uvCount; ++i)
@@ -1153,17 +1933,15 @@ void UMechanismComponent::GetVHLFieldAsGraphicsMesh(FString VHLName, FString Fie
             }
 
             Normals.SetNum(Normals.Num() + MeshData.normalCount);
-            for (std::uint32_t i = 0; i < MeshData.normalCount; ++i)
-            {
-                double dir[3] = { MeshData.normals[i * 3], MeshData.normals[i * 3 + 1], MeshData.normals[i * 3 + 2] };
-                Normals[i] = VortexIntegrationUtilities::ConvertDirection(dir);
-            }
+            VortexIntegrationUtilities::ConvertDirections(MeshData.normals, MeshData.normalCount, Normals.GetData());
 
+            TArray<FVector> TangentDirections;
+            TangentDirections.SetNumUninitialized(MeshData.tangentCount);
+            VortexIntegrationUtilities::ConvertDirections(MeshData.tangents, MeshData.tangentCount, TangentDirections.GetData());
             Tangents.SetNum(Tangents.Num() + MeshData.tangentCount);
             for (std::uint32_t i = 0; i < MeshData.tangentCount; ++i)
             {
-                double dir[3] = { MeshData.tangents[i * 3], MeshData.tangents[i * 3 + 1], MeshData.tangents[i * 3 + 2] };
-                Tangents[i] = FProcMeshTangent(VortexIntegrationUtilities::ConvertDirection(dir), false);
+                Tangents[i] = FProcMeshTangent(TangentDirections[i], false);
             }
         }
     }
@@ -1281,25 +2059,1064 @@ void UMechanismComponent::GetVHLFieldAsGraphicsMaterial(FString VHLName, FString
     }
 }
 
-bool UMechanismComponent::PreValidateVHLFunction(const FString& FunctionName, const FString& FilePath, const FString& VHLName, const FString& FieldName)
+FVortexFieldHandle UMechanismComponent::ResolveVHLField(FString VHLName, FString FieldName, EVortexVHLFieldType FieldType, EVortexVHLDataType DataType, bool& bOK)
 {
-    bool CanCallVHLFunction = true;
+    bOK = false;
+    FVortexFieldHandle Handle;
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+        return Handle;
 
-    FString ActorName = "";
-    if (AActor * Actor = GetOwner())
+    if (!PreValidateVHLFunction("ResolveVHLField", VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
     {
-        ActorName = Actor->GetName();
+        return Handle;
     }
 
-    if (!HasBegunPlay())
+    const VortexFieldType VxFieldType = VortexFieldHandle::ToVortexFieldType(FieldType);
+    const VortexDataType VxDataType = VortexFieldHandle::ToVortexDataType(DataType);
+    if (VortexGetFieldStatus(VortexObject, TCHAR_TO_UTF8(*VHLName), TCHAR_TO_UTF8(*FieldName), VxFieldType, VxDataType) != kVortexFieldStatusOK)
+    {
+        LogErrorForVHLFunction("ResolveVHLField", VortexMechanism->MechanismFilepath.FilePath, VortexObject, VHLName, FieldName, VxFieldType, VxDataType);
+        return Handle;
+    }
+
+    CopyAsUTF8(VHLName, Handle.InterfaceName);
+    CopyAsUTF8(FieldName, Handle.FieldName);
+    Handle.FieldType = FieldType;
+    Handle.DataType = DataType;
+    Handle.VortexObject = VortexObject;
+    Handle.Generation = FieldHandleGeneration;
+    bOK = true;
+    return Handle;
+}
+
+bool UMechanismComponent::IsVHLFieldHandleValid(const FVortexFieldHandle& Handle) const
+{
+    return Handle.VortexObject != nullptr && Handle.VortexObject == VortexObject && Handle.Generation == FieldHandleGeneration;
+}
+
+void UMechanismComponent::GetVHLFieldHandleAsBool(const FVortexFieldHandle& Handle, bool& Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    if (!PreValidateVHLFieldHandle(TEXT("GetVHLFieldHandleAsBool"), Handle, EVortexVHLFieldType::Output, EVortexVHLDataType::Boolean))
+    {
+        return;
+    }
+
+    if (!VortexGetOutputBoolean(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), &Value))
+    {
+        LogErrorForVHLFieldHandle(TEXT("GetVHLFieldHandleAsBool"), Handle);
+    }
+}
+
+void UMechanismComponent::SetVHLFieldHandleAsBool(const FVortexFieldHandle& Handle, bool Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldHandleAsBool, Handle, Value))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFieldHandle(TEXT("SetVHLFieldHandleAsBool"), Handle, EVortexVHLFieldType::Input, EVortexVHLDataType::Boolean))
+    {
+        return;
+    }
+
+    if (!VortexSetInputBoolean(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Value))
+    {
+        LogErrorForVHLFieldHandle(TEXT("SetVHLFieldHandleAsBool"), Handle);
+    }
+}
+
+void UMechanismComponent::GetVHLFieldHandleAsInteger(const FVortexFieldHandle& Handle, int32& Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    if (!PreValidateVHLFieldHandle(TEXT("GetVHLFieldHandleAsInteger"), Handle, EVortexVHLFieldType::Output, EVortexVHLDataType::Integer))
+    {
+        return;
+    }
+
+    if (!VortexGetOutputInt(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), &Value))
+    {
+        LogErrorForVHLFieldHandle(TEXT("GetVHLFieldHandleAsInteger"), Handle);
+    }
+}
+
+void UMechanismComponent::SetVHLFieldHandleAsInteger(const FVortexFieldHandle& Handle, int32 Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldHandleAsInteger, Handle, Value))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFieldHandle(TEXT("SetVHLFieldHandleAsInteger"), Handle, EVortexVHLFieldType::Input, EVortexVHLDataType::Integer))
+    {
+        return;
+    }
+
+    if (!VortexSetInputInt(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Value))
+    {
+        LogErrorForVHLFieldHandle(TEXT("SetVHLFieldHandleAsInteger"), Handle);
+    }
+}
+
+void UMechanismComponent::GetVHLFieldHandleAsFloat(const FVortexFieldHandle& Handle, float& Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    if (!PreValidateVHLFieldHandle(TEXT("GetVHLFieldHandleAsFloat"), Handle, EVortexVHLFieldType::Output, EVortexVHLDataType::Float))
+    {
+        return;
+    }
+
+    double VxValue;
+    if (VortexGetOutputReal(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), &VxValue))
+    {
+        Value = VxValue;
+    }
+    else
+    {
+        LogErrorForVHLFieldHandle(TEXT("GetVHLFieldHandleAsFloat"), Handle);
+    }
+}
+
+void UMechanismComponent::SetVHLFieldHandleAsFloat(const FVortexFieldHandle& Handle, float Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldHandleAsFloat, Handle, Value))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFieldHandle(TEXT("SetVHLFieldHandleAsFloat"), Handle, EVortexVHLFieldType::Input, EVortexVHLDataType::Float))
+    {
+        return;
+    }
+
+    if (!VortexSetInputReal(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Value))
+    {
+        LogErrorForVHLFieldHandle(TEXT("SetVHLFieldHandleAsFloat"), Handle);
+    }
+}
+
+void UMechanismComponent::GetVHLFieldHandleAsVector2(const FVortexFieldHandle& Handle, FVector2D& Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    if (!PreValidateVHLFieldHandle(TEXT("GetVHLFieldHandleAsVector2"), Handle, EVortexVHLFieldType::Output, EVortexVHLDataType::Vector2))
+    {
+        return;
+    }
+
+    double VxValue[2];
+    if (VortexGetOutputVector2(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue))
+    {
+        Value = FVector2D(VxValue[0], VxValue[1]);
+    }
+    else
+    {
+        LogErrorForVHLFieldHandle(TEXT("GetVHLFieldHandleAsVector2"), Handle);
+    }
+}
+
+void UMechanismComponent::SetVHLFieldHandleAsVector2(const FVortexFieldHandle& Handle, FVector2D Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldHandleAsVector2, Handle, Value))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFieldHandle(TEXT("SetVHLFieldHandleAsVector2"), Handle, EVortexVHLFieldType::Input, EVortexVHLDataType::Vector2))
+    {
+        return;
+    }
+
+    double VxValue[2] = { Value.X, Value.Y };
+    if (!VortexSetInputVector2(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue))
+    {
+        LogErrorForVHLFieldHandle(TEXT("SetVHLFieldHandleAsVector2"), Handle);
+    }
+}
+
+void UMechanismComponent::GetVHLFieldHandleAsVector3(const FVortexFieldHandle& Handle, FVector& Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    if (!PreValidateVHLFieldHandle(TEXT("GetVHLFieldHandleAsVector3"), Handle, EVortexVHLFieldType::Output, EVortexVHLDataType::Vector3))
+    {
+        return;
+    }
+
+    double VxValue[3];
+    if (VortexGetOutputVector3(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue))
+    {
+        Value = FVector(VxValue[0], VxValue[1], VxValue[2]);
+    }
+    else
+    {
+        LogErrorForVHLFieldHandle(TEXT("GetVHLFieldHandleAsVector3"), Handle);
+    }
+}
+
+void UMechanismComponent::SetVHLFieldHandleAsVector3(const FVortexFieldHandle& Handle, FVector Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldHandleAsVector3, Handle, Value))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFieldHandle(TEXT("SetVHLFieldHandleAsVector3"), Handle, EVortexVHLFieldType::Input, EVortexVHLDataType::Vector3))
+    {
+        return;
+    }
+
+    double VxValue[3] = { Value.X, Value.Y, Value.Z };
+    if (!VortexSetInputVector3(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue))
+    {
+        LogErrorForVHLFieldHandle(TEXT("SetVHLFieldHandleAsVector3"), Handle);
+    }
+}
+
+void UMechanismComponent::GetVHLFieldHandleAsVector4(const FVortexFieldHandle& Handle, FVector4& Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    if (!PreValidateVHLFieldHandle(TEXT("GetVHLFieldHandleAsVector4"), Handle, EVortexVHLFieldType::Output, EVortexVHLDataType::Vector4))
+    {
+        return;
+    }
+
+    double VxValue[4];
+    if (VortexGetOutputVector4(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue))
+    {
+        Value = FVector4(VxValue[0], VxValue[1], VxValue[2], VxValue[3]);
+    }
+    else
+    {
+        LogErrorForVHLFieldHandle(TEXT("GetVHLFieldHandleAsVector4"), Handle);
+    }
+}
+
+void UMechanismComponent::SetVHLFieldHandleAsVector4(const FVortexFieldHandle& Handle, FVector4 Value)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldHandleAsVector4, Handle, Value))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFieldHandle(TEXT("SetVHLFieldHandleAsVector4"), Handle, EVortexVHLFieldType::Input, EVortexVHLDataType::Vector4))
+    {
+        return;
+    }
+
+    double VxValue[4] = { Value.X, Value.Y, Value.Z, Value.W };
+    if (!VortexSetInputVector4(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue))
+    {
+        LogErrorForVHLFieldHandle(TEXT("SetVHLFieldHandleAsVector4"), Handle);
+    }
+}
+
+void UMechanismComponent::GetVHLFieldHandleAsTransform(const FVortexFieldHandle& Handle, FTransform& Transform)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValueTransform);
+    if (!PreValidateVHLFieldHandle(TEXT("GetVHLFieldHandleAsTransform"), Handle, EVortexVHLFieldType::Output, EVortexVHLDataType::Transform))
+    {
+        return;
+    }
+
+    double Translation[3];
+    double Rotation[4];
+    if (VortexGetOutputMatrix(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Translation, Rotation))
+    {
+        Transform = VortexIntegrationUtilities::ConvertTransform(Translation, Rotation);
+    }
+    else
+    {
+        LogErrorForVHLFieldHandle(TEXT("GetVHLFieldHandleAsTransform"), Handle);
+    }
+}
+
+void UMechanismComponent::SetVHLFieldHandleAsTransform(const FVortexFieldHandle& Handle, FTransform Transform)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValueTransform);
+    if (DeferUntilStepBoundary(this, &UMechanismComponent::SetVHLFieldHandleAsTransform, Handle, Transform))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFieldHandle(TEXT("SetVHLFieldHandleAsTransform"), Handle, EVortexVHLFieldType::Input, EVortexVHLDataType::Transform))
+    {
+        return;
+    }
+
+    double Translation[3];
+    double Rotation[4];
+    VortexIntegrationUtilities::ConvertTransform(Transform, Translation, Rotation);
+
+    if (!VortexSetInputMatrix(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Translation, Rotation))
+    {
+        LogErrorForVHLFieldHandle(TEXT("SetVHLFieldHandleAsTransform"), Handle);
+    }
+}
+
+int32 UMechanismComponent::CreateVHLBatch(const TArray<FVortexFieldHandle>& Inputs, const TArray<FVortexFieldHandle>& Outputs, bool& bOK)
+{
+    bOK = false;
+    for (const FVortexFieldHandle& Handle : Inputs)
+    {
+        if (!PreValidateVHLFieldHandle(TEXT("CreateVHLBatch"), Handle, EVortexVHLFieldType::Input, Handle.DataType))
+        {
+            return INDEX_NONE;
+        }
+    }
+
+    for (const FVortexFieldHandle& Handle : Outputs)
+    {
+        if (!PreValidateVHLFieldHandle(TEXT("CreateVHLBatch"), Handle, EVortexVHLFieldType::Output, Handle.DataType))
+        {
+            return INDEX_NONE;
+        }
+    }
+
+    const int32 BatchId = NextVHLBatchId++;
+    FMechanismVHLBatch& Batch = VHLBatches.Add(BatchId);
+    Batch.Inputs = Inputs;
+    Batch.Outputs = Outputs;
+    Batch.InputValues.Allocate(Inputs);
+    Batch.bInputsPending = false;
+    Batch.OutputValues.Allocate(Outputs);
+
+    bOK = true;
+    return BatchId;
+}
+
+void UMechanismComponent::DestroyVHLBatch(int32 BatchId)
+{
+    VHLBatches.Remove(BatchId);
+}
+
+void UMechanismComponent::SetVHLBatchInputs(int32 BatchId, const FVortexVHLBatchValues& Values)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    FMechanismVHLBatch* Batch = VHLBatches.Find(BatchId);
+    if (Batch == nullptr)
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::SetVHLBatchInputs(): Batch %d does not exist. Batches are destroyed when the component is unregistered."), BatchId);
+        return;
+    }
+
+    if (!Values.HasSameLayout(Batch->InputValues))
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::SetVHLBatchInputs(): Batch %d. The number of values of each data type must match the number of input fields of that type."), BatchId);
+        return;
+    }
+
+    Batch->InputValues = Values;
+    Batch->bInputsPending = true;
+}
+
+void UMechanismComponent::GetVHLBatchOutputs(int32 BatchId, FVortexVHLBatchValues& Values)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    const FMechanismVHLBatch* Batch = VHLBatches.Find(BatchId);
+    if (Batch == nullptr)
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::GetVHLBatchOutputs(): Batch %d does not exist. Batches are destroyed when the component is unregistered."), BatchId);
+        return;
+    }
+
+    Values = Batch->OutputValues;
+}
+
+void UMechanismComponent::FlushVHLBatchInputs()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlushVHLBatchInputs);
+    for (auto& pair : VHLBatches)
+    {
+        FMechanismVHLBatch& Batch = pair.Value;
+        if (!Batch.bInputsPending)
+        {
+            continue;
+        }
+        Batch.bInputsPending = false;
+
+        const FVortexVHLBatchValues& Values = Batch.InputValues;
+        int32 Indices[static_cast<int32>(EVortexVHLDataType::Transform) + 1] = {};
+        for (const FVortexFieldHandle& Handle : Batch.Inputs)
+        {
+            const int32 Index = Indices[static_cast<int32>(Handle.DataType)]++;
+            if (!Handle.WriteInput(Values, Index))
+            {
+                LogErrorForVHLFieldHandle(TEXT("FlushVHLBatchInputs"), Handle);
+            }
+        }
+    }
+}
+
+void UMechanismComponent::GatherVHLBatchOutputs()
+{
+    SCOPE_CYCLE_COUNTER(STAT_GatherVHLBatchOutputs);
+    for (auto& pair : VHLBatches)
+    {
+        FMechanismVHLBatch& Batch = pair.Value;
+        FVortexVHLBatchValues& Values = Batch.OutputValues;
+        int32 Indices[static_cast<int32>(EVortexVHLDataType::Transform) + 1] = {};
+        for (const FVortexFieldHandle& Handle : Batch.Outputs)
+        {
+            const int32 Index = Indices[static_cast<int32>(Handle.DataType)]++;
+            if (!Handle.ReadOutput(Values, Index))
+            {
+                LogErrorForVHLFieldHandle(TEXT("GatherVHLBatchOutputs"), Handle);
+            }
+        }
+    }
+}
+
+int32 UMechanismComponent::SubscribeVHLOutputChanges(const FVortexFieldHandle& Handle, float Epsilon, const FVortexVHLOutputChanged& OnChanged, bool& bOK)
+{
+    bOK = false;
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+        return INDEX_NONE;
+
+    if (!PreValidateVHLFieldHandle(TEXT("SubscribeVHLOutputChanges"), Handle, EVortexVHLFieldType::Output, Handle.DataType))
+    {
+        return INDEX_NONE;
+    }
+
+    if (!OnChanged.IsBound())
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::SubscribeVHLOutputChanges(): Interface \"%s\" and field \"%s\". No delegate was given."), UTF8_TO_TCHAR(Handle.GetInterfaceName()), UTF8_TO_TCHAR(Handle.GetFieldName()));
+        return INDEX_NONE;
+    }
+
+    FMechanismVHLOutputSubscription Subscription;
+    Subscription.Handle = Handle;
+    Subscription.Epsilon = FMath::Max(0.0f, Epsilon);
+    Subscription.OnChanged = OnChanged;
+    Subscription.Value.Allocate({ Handle });
+    Subscription.bReported = false;
+
+    const int32 SubscriptionId = NextVHLOutputSubscriptionId++;
+    VHLOutputSubscriptions.Add(SubscriptionId, MoveTemp(Subscription));
+    bOK = true;
+    return SubscriptionId;
+}
+
+void UMechanismComponent::UnsubscribeVHLOutputChanges(int32 SubscriptionId)
+{
+    VHLOutputSubscriptions.Remove(SubscriptionId);
+}
+
+void UMechanismComponent::DispatchVHLOutputChanges()
+{
+    SCOPE_CYCLE_COUNTER(STAT_DispatchVHLOutputChanges);
+    if (VHLOutputSubscriptions.Num() == 0)
+    {
+        return;
+    }
+
+    // Compare everything first, delegates are free to subscribe or unsubscribe
+    TArray<TPair<FVortexVHLOutputChanged, FVortexFieldHandle>> Changed;
+    TArray<FVortexVHLValue> ChangedValues;
+    for (auto& pair : VHLOutputSubscriptions)
+    {
+        FMechanismVHLOutputSubscription& Subscription = pair.Value;
+        if (!Subscription.Handle.ReadOutput(Subscription.Value, 0))
+        {
+            LogErrorForVHLFieldHandle(TEXT("DispatchVHLOutputChanges"), Subscription.Handle);
+            continue;
+        }
+
+        if (UpdateReportedVHLValue(Subscription.Handle.DataType, Subscription.Value, Subscription.Epsilon, Subscription.ReportedValue) || !Subscription.bReported)
+        {
+            Subscription.bReported = true;
+            Changed.Emplace(Subscription.OnChanged, Subscription.Handle);
+            ChangedValues.Add(Subscription.ReportedValue);
+        }
+    }
+    INC_DWORD_STAT_BY(STAT_VHLOutputChanges, Changed.Num());
+
+    for (int32 i = 0; i < Changed.Num(); ++i)
+    {
+        Changed[i].Key.ExecuteIfBound(Changed[i].Value, ChangedValues[i]);
+    }
+}
+
+int32 UMechanismComponent::BindVHLStruct(FString VHLName, const UScriptStruct* StructType, bool& bOK)
+{
+    bOK = false;
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+        return INDEX_NONE;
+
+    if (StructType == nullptr)
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::BindVHLStruct(): Interface \"%s\". No struct type was given."), *VHLName);
+        return INDEX_NONE;
+    }
+
+    if (!PreValidateVHLFunction("BindVHLStruct", VortexMechanism->MechanismFilepath.FilePath, VHLName, StructType->GetName()))
+    {
+        return INDEX_NONE;
+    }
+
+    FMechanismVHLStructBinding Binding;
+    Binding.Struct = StructType;
+    for (TFieldIterator<FProperty> It(StructType); It; ++It)
+    {
+        const FProperty* Property = *It;
+        const FString FieldName = Property->GetName();
+
+        EVortexVHLDataType DataType;
+        if (!GetVHLDataType(Property, DataType))
+        {
+            UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::BindVHLStruct(): Struct \"%s\", property \"%s\". Only bool, int32, float, double, FVector2D, FVector, FVector4 and FTransform properties can be bound to VHL fields."), *StructType->GetName(), *FieldName);
+            return INDEX_NONE;
+        }
+
+        // The direction of the field is given by the VHL interface
+        const VortexDataType VxDataType = VortexFieldHandle::ToVortexDataType(DataType);
+        EVortexVHLFieldType FieldType;
+        if (VortexGetFieldStatus(VortexObject, TCHAR_TO_UTF8(*VHLName), TCHAR_TO_UTF8(*FieldName), kVortexFieldTypeInput, VxDataType) == kVortexFieldStatusOK)
+        {
+            FieldType = EVortexVHLFieldType::Input;
+        }
+        else if (VortexGetFieldStatus(VortexObject, TCHAR_TO_UTF8(*VHLName), TCHAR_TO_UTF8(*FieldName), kVortexFieldTypeOutput, VxDataType) == kVortexFieldStatusOK)
+        {
+            FieldType = EVortexVHLFieldType::Output;
+        }
+        else
+        {
+            LogErrorForVHLFunction("BindVHLStruct", VortexMechanism->MechanismFilepath.FilePath, VortexObject, VHLName, FieldName, kVortexFieldTypeOutput, VxDataType);
+            return INDEX_NONE;
+        }
+
+        FMechanismVHLStructField Field;
+        CopyAsUTF8(VHLName, Field.Handle.InterfaceName);
+        CopyAsUTF8(FieldName, Field.Handle.FieldName);
+        Field.Handle.FieldType = FieldType;
+        Field.Handle.DataType = DataType;
+        Field.Handle.VortexObject = VortexObject;
+        Field.Handle.Generation = FieldHandleGeneration;
+        Field.Property = Property;
+        Field.BoolProperty = CastField<FBoolProperty>(Property);
+        Field.bDouble = Property->IsA<FDoubleProperty>();
+        (FieldType == EVortexVHLFieldType::Input ? Binding.Inputs : Binding.Outputs).Add(MoveTemp(Field));
+    }
+
+    const int32 BindingId = NextVHLStructBindingId++;
+    VHLStructBindings.Add(BindingId, MoveTemp(Binding));
+    bOK = true;
+    return BindingId;
+}
+
+void UMechanismComponent::UnbindVHLStruct(int32 BindingId)
+{
+    VHLStructBindings.Remove(BindingId);
+}
+
+void UMechanismComponent::SetVHLStruct(int32, const int32&)
+{
+    // Only called through execSetVHLStruct
+    check(0);
+}
+
+void UMechanismComponent::GetVHLStruct(int32, int32&)
+{
+    // Only called through execGetVHLStruct
+    check(0);
+}
+
+DEFINE_FUNCTION(UMechanismComponent::execSetVHLStruct)
+{
+    P_GET_PROPERTY(FIntProperty, BindingId);
+
+    Stack.StepCompiledIn<FStructProperty>(nullptr);
+    const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+    const void* Data = Stack.MostRecentPropertyAddress;
+
+    P_FINISH;
+
+    P_NATIVE_BEGIN;
+    P_THIS->SetVHLStructData(BindingId, StructProperty ? StructProperty->Struct : nullptr, Data);
+    P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UMechanismComponent::execGetVHLStruct)
+{
+    P_GET_PROPERTY(FIntProperty, BindingId);
+
+    Stack.StepCompiledIn<FStructProperty>(nullptr);
+    const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+    void* Data = Stack.MostRecentPropertyAddress;
+
+    P_FINISH;
+
+    P_NATIVE_BEGIN;
+    P_THIS->GetVHLStructData(BindingId, StructProperty ? StructProperty->Struct : nullptr, Data);
+    P_NATIVE_END;
+}
+
+const FMechanismVHLStructBinding* UMechanismComponent::FindVHLStructBinding(const TCHAR* FunctionName, int32 BindingId, const UScriptStruct* StructType) const
+{
+    const FMechanismVHLStructBinding* Binding = VHLStructBindings.Find(BindingId);
+    if (Binding == nullptr)
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::%s(): Struct binding %d does not exist. Bindings are removed when the component is unregistered."), FunctionName, BindingId);
+        return nullptr;
+    }
+
+    if (StructType == nullptr || Binding->Struct.Get() != StructType)
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::%s(): Struct binding %d. The value is not of the bound struct type."), FunctionName, BindingId);
+        return nullptr;
+    }
+
+    return Binding;
+}
+
+void UMechanismComponent::SetVHLStructData(int32 BindingId, const UScriptStruct* StructType, const void* Data)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SetVHLValue);
+    if (!FVortexRuntimeModule::IsIntegrationLoaded() || Data == nullptr)
+        return;
+
+    const FMechanismVHLStructBinding* Binding = FindVHLStructBinding(TEXT("SetVHLStruct"), BindingId, StructType);
+    if (Binding == nullptr)
+    {
+        return;
+    }
+
+    // Only the bound plain values are read, so a bitwise copy of the struct can be applied at the next step boundary
+    if (FVortexRuntimeModule::Get().IsSimulationStepInFlight())
+    {
+        TArray<uint8> DeferredData(static_cast<const uint8*>(Data), StructType->GetStructureSize());
+        TWeakObjectPtr<UMechanismComponent> WeakComponent(this);
+        FVortexRuntimeModule::Get().DeferUntilStepBoundary([WeakComponent, BindingId, StructType, DeferredData]()
+        {
+            if (UMechanismComponent* DeferredComponent = WeakComponent.Get())
+            {
+                DeferredComponent->SetVHLStructData(BindingId, StructType, DeferredData.GetData());
+            }
+        });
+        return;
+    }
+
+    for (const FMechanismVHLStructField& Field : Binding->Inputs)
+    {
+        const FVortexFieldHandle& Handle = Field.Handle;
+        const uint8* Value = Field.Property->ContainerPtrToValuePtr<uint8>(Data);
+        bool bSuccess = false;
+        switch (Handle.DataType)
+        {
+        case EVortexVHLDataType::Boolean:
+            bSuccess = VortexSetInputBoolean(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Field.BoolProperty->GetPropertyValue(Value));
+            break;
+        case EVortexVHLDataType::Integer:
+            bSuccess = VortexSetInputInt(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), *reinterpret_cast<const int32*>(Value));
+            break;
+        case EVortexVHLDataType::Float:
+        {
+            const double VxValue = Field.bDouble ? *reinterpret_cast<const double*>(Value) : *reinterpret_cast<const float*>(Value);
+            bSuccess = VortexSetInputReal(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue);
+            break;
+        }
+        case EVortexVHLDataType::Vector2:
+        {
+            const FVector2D& Vector = *reinterpret_cast<const FVector2D*>(Value);
+            double VxValue[2] = { Vector.X, Vector.Y };
+            bSuccess = VortexSetInputVector2(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue);
+            break;
+        }
+        case EVortexVHLDataType::Vector3:
+        {
+            const FVector& Vector = *reinterpret_cast<const FVector*>(Value);
+            double VxValue[3] = { Vector.X, Vector.Y, Vector.Z };
+            bSuccess = VortexSetInputVector3(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue);
+            break;
+        }
+        case EVortexVHLDataType::Vector4:
+        {
+            const FVector4& Vector = *reinterpret_cast<const FVector4*>(Value);
+            double VxValue[4] = { Vector.X, Vector.Y, Vector.Z, Vector.W };
+            bSuccess = VortexSetInputVector4(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue);
+            break;
+        }
+        case EVortexVHLDataType::Transform:
+        {
+            double Translation[3];
+            double Rotation[4];
+            VortexIntegrationUtilities::ConvertTransform(*reinterpret_cast<const FTransform*>(Value), Translation, Rotation);
+            bSuccess = VortexSetInputMatrix(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Translation, Rotation);
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (!bSuccess)
+        {
+            LogErrorForVHLFieldHandle(TEXT("SetVHLStruct"), Handle);
+        }
+    }
+}
+
+void UMechanismComponent::GetVHLStructData(int32 BindingId, const UScriptStruct* StructType, void* Data)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GetVHLValue);
+    if (!FVortexRuntimeModule::IsIntegrationLoaded() || Data == nullptr)
+        return;
+
+    const FMechanismVHLStructBinding* Binding = FindVHLStructBinding(TEXT("GetVHLStruct"), BindingId, StructType);
+    if (Binding == nullptr)
+    {
+        return;
+    }
+
+    // The Vortex application must not be used while a step is running on the simulation thread
+    FVortexRuntimeModule::Get().WaitForSimulationStep();
+
+    for (const FMechanismVHLStructField& Field : Binding->Outputs)
+    {
+        const FVortexFieldHandle& Handle = Field.Handle;
+        uint8* Value = Field.Property->ContainerPtrToValuePtr<uint8>(Data);
+        bool bSuccess = false;
+        switch (Handle.DataType)
+        {
+        case EVortexVHLDataType::Boolean:
+        {
+            bool VxValue;
+            bSuccess = VortexGetOutputBoolean(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), &VxValue);
+            if (bSuccess)
+            {
+                Field.BoolProperty->SetPropertyValue(Value, VxValue);
+            }
+            break;
+        }
+        case EVortexVHLDataType::Integer:
+            bSuccess = VortexGetOutputInt(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), reinterpret_cast<int32*>(Value));
+            break;
+        case EVortexVHLDataType::Float:
+        {
+            double VxValue;
+            bSuccess = VortexGetOutputReal(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), &VxValue);
+            if (bSuccess && Field.bDouble)
+            {
+                *reinterpret_cast<double*>(Value) = VxValue;
+            }
+            else if (bSuccess)
+            {
+                *reinterpret_cast<float*>(Value) = VxValue;
+            }
+            break;
+        }
+        case EVortexVHLDataType::Vector2:
+        {
+            double VxValue[2];
+            bSuccess = VortexGetOutputVector2(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue);
+            if (bSuccess)
+            {
+                *reinterpret_cast<FVector2D*>(Value) = FVector2D(VxValue[0], VxValue[1]);
+            }
+            break;
+        }
+        case EVortexVHLDataType::Vector3:
+        {
+            double VxValue[3];
+            bSuccess = VortexGetOutputVector3(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue);
+            if (bSuccess)
+            {
+                *reinterpret_cast<FVector*>(Value) = FVector(VxValue[0], VxValue[1], VxValue[2]);
+            }
+            break;
+        }
+        case EVortexVHLDataType::Vector4:
+        {
+            double VxValue[4];
+            bSuccess = VortexGetOutputVector4(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), VxValue);
+            if (bSuccess)
+            {
+                *reinterpret_cast<FVector4*>(Value) = FVector4(VxValue[0], VxValue[1], VxValue[2], VxValue[3]);
+            }
+            break;
+        }
+        case EVortexVHLDataType::Transform:
+        {
+            double Translation[3];
+            double Rotation[4];
+            bSuccess = VortexGetOutputMatrix(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Translation, Rotation);
+            if (bSuccess)
+            {
+                *reinterpret_cast<FTransform*>(Value) = VortexIntegrationUtilities::ConvertTransform(Translation, Rotation);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (!bSuccess)
+        {
+            LogErrorForVHLFieldHandle(TEXT("GetVHLStruct"), Handle);
+        }
+    }
+}
+
+void UMechanismComponent::QueueVHLFieldAsBool(FString VHLName, FString FieldName, bool Value, float SimulationTime)
+{
+    FMechanismQueuedInput Input = {};
+    Input.SimulationTime = SimulationTime;
+    Input.IntegerValue = Value ? 1 : 0;
+    QueueVHLInput("QueueVHLFieldAsBool", VHLName, FieldName, kVortexDataTypeBoolean, false, Input);
+}
+
+void UMechanismComponent::QueueVHLFieldAsInteger(FString VHLName, FString FieldName, int32 Value, float SimulationTime)
+{
+    FMechanismQueuedInput Input = {};
+    Input.SimulationTime = SimulationTime;
+    Input.IntegerValue = Value;
+    QueueVHLInput("QueueVHLFieldAsInteger", VHLName, FieldName, kVortexDataTypeInt, false, Input);
+}
+
+void UMechanismComponent::QueueVHLFieldAsFloat(FString VHLName, FString FieldName, float Value, float SimulationTime, bool bInterpolate)
+{
+    FMechanismQueuedInput Input = {};
+    Input.SimulationTime = SimulationTime;
+    Input.RealValue[0] = Value;
+    QueueVHLInput("QueueVHLFieldAsFloat", VHLName, FieldName, kVortexDataTypeReal, bInterpolate, Input);
+}
+
+void UMechanismComponent::QueueVHLFieldAsVector2(FString VHLName, FString FieldName, FVector2D Value, float SimulationTime, bool bInterpolate)
+{
+    FMechanismQueuedInput Input = {};
+    Input.SimulationTime = SimulationTime;
+    Input.RealValue[0] = Value.X;
+    Input.RealValue[1] = Value.Y;
+    QueueVHLInput("QueueVHLFieldAsVector2", VHLName, FieldName, kVortexDataTypeVector2, bInterpolate, Input);
+}
+
+void UMechanismComponent::QueueVHLFieldAsVector3(FString VHLName, FString FieldName, FVector Value, float SimulationTime, bool bInterpolate)
+{
+    FMechanismQueuedInput Input = {};
+    Input.SimulationTime = SimulationTime;
+    Input.RealValue[0] = Value.X;
+    Input.RealValue[1] = Value.Y;
+    Input.RealValue[2] = Value.Z;
+    QueueVHLInput("QueueVHLFieldAsVector3", VHLName, FieldName, kVortexDataTypeVector3, bInterpolate, Input);
+}
+
+void UMechanismComponent::QueueVHLFieldAsVector4(FString VHLName, FString FieldName, FVector4 Value, float SimulationTime, bool bInterpolate)
+{
+    FMechanismQueuedInput Input = {};
+    Input.SimulationTime = SimulationTime;
+    Input.RealValue[0] = Value.X;
+    Input.RealValue[1] = Value.Y;
+    Input.RealValue[2] = Value.Z;
+    Input.RealValue[3] = Value.W;
+    QueueVHLInput("QueueVHLFieldAsVector4", VHLName, FieldName, kVortexDataTypeVector4, bInterpolate, Input);
+}
+
+void UMechanismComponent::ClearVHLInputQueue()
+{
+    QueuedInputTracks.Empty();
+}
+
+void UMechanismComponent::QueueVHLInput(const FString& FunctionName, const FString& VHLName, const FString& FieldName, VortexDataType DataType, bool bInterpolate, const FMechanismQueuedInput& Input)
+{
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+        return;
+
+    TWeakObjectPtr<UMechanismComponent> WeakComponent(this);
+    if (DeferUntilMechanismLoaded([WeakComponent, FunctionName, VHLName, FieldName, DataType, bInterpolate, Input]()
+        {
+            if (UMechanismComponent* DeferredComponent = WeakComponent.Get())
+            {
+                DeferredComponent->QueueVHLInput(FunctionName, VHLName, FieldName, DataType, bInterpolate, Input);
+            }
+        }))
+    {
+        return;
+    }
+
+    if (!PreValidateVHLFunction(FunctionName, VortexMechanism->MechanismFilepath.FilePath, VHLName, FieldName))
+    {
+        return;
+    }
+
+    FMechanismQueuedInputTrack* Track = QueuedInputTracks.FindByPredicate([&VHLName, &FieldName](const FMechanismQueuedInputTrack& Candidate)
+    {
+        return Candidate.VHLName == VHLName && Candidate.FieldName == FieldName;
+    });
+
+    if (Track == nullptr)
+    {
+        if (VortexGetFieldStatus(VortexObject, TCHAR_TO_UTF8(*VHLName), TCHAR_TO_UTF8(*FieldName), kVortexFieldTypeInput, DataType) != kVortexFieldStatusOK)
+        {
+            LogErrorForVHLFunction(FunctionName, VortexMechanism->MechanismFilepath.FilePath, VortexObject, VHLName, FieldName, kVortexFieldTypeInput, DataType);
+            return;
+        }
+
+        Track = &QueuedInputTracks.AddDefaulted_GetRef();
+        Track->VHLName = VHLName;
+        Track->FieldName = FieldName;
+        Track->DataType = DataType;
+    }
+    else if (Track->DataType != DataType)
+    {
+        LogErrorForVHLFunction(FunctionName, VortexMechanism->MechanismFilepath.FilePath, VortexObject, VHLName, FieldName, kVortexFieldTypeInput, DataType);
+        return;
+    }
+
+    Track->bInterpolate = bInterpolate;
+
+    // Keep the inputs sorted, a value queued at the same time as an existing one replaces it
+    const int32 Index = Algo::LowerBoundBy(Track->Inputs, Input.SimulationTime, &FMechanismQueuedInput::SimulationTime);
+    if (Track->Inputs.IsValidIndex(Index) && Track->Inputs[Index].SimulationTime == Input.SimulationTime)
+    {
+        Track->Inputs[Index] = Input;
+    }
+    else
+    {
+        Track->Inputs.Insert(Input, Index);
+    }
+}
+
+void UMechanismComponent::ApplyQueuedVHLInputs(double SimulationTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ApplyQueuedVHLInputs);
+    if (VortexObject == nullptr)
+    {
+        return;
+    }
+
+    for (FMechanismQueuedInputTrack& Track : QueuedInputTracks)
+    {
+        // Latest input due at this time, the ones before are outdated
+        const int32 Current = Algo::UpperBoundBy(Track.Inputs, SimulationTime, &FMechanismQueuedInput::SimulationTime) - 1;
+        if (Current < 0)
+        {
+            continue;
+        }
+        Track.Inputs.RemoveAt(0, Current, false);
+
+        FMechanismQueuedInput Value = Track.Inputs[0];
+        const bool bInterpolating = Track.bInterpolate && Track.Inputs.Num() > 1 && Track.DataType != kVortexDataTypeBoolean && Track.DataType != kVortexDataTypeInt;
+        if (bInterpolating)
+        {
+            const FMechanismQueuedInput& Next = Track.Inputs[1];
+            const double Alpha = (SimulationTime - Value.SimulationTime) / (Next.SimulationTime - Value.SimulationTime);
+            for (int i = 0; i < 4; ++i)
+            {
+                Value.RealValue[i] = FMath::Lerp(Value.RealValue[i], Next.RealValue[i], Alpha);
+            }
+        }
+        else if (Track.Inputs[0].bApplied)
+        {
+            continue;
+        }
+        Track.Inputs[0].bApplied = true;
+
+        const FTCHARToUTF8 VHLName(*Track.VHLName);
+        const FTCHARToUTF8 FieldName(*Track.FieldName);
+        const char* VHLNameUtf8 = VHLName.Get();
+        const char* FieldNameUtf8 = FieldName.Get();
+
+        bool bSuccess = false;
+        switch (Track.DataType)
+        {
+        case kVortexDataTypeBoolean:
+            bSuccess = VortexSetInputBoolean(VortexObject, VHLNameUtf8, FieldNameUtf8, Value.IntegerValue != 0);
+            break;
+        case kVortexDataTypeInt:
+            bSuccess = VortexSetInputInt(VortexObject, VHLNameUtf8, FieldNameUtf8, Value.IntegerValue);
+            break;
+        case kVortexDataTypeReal:
+            bSuccess = VortexSetInputReal(VortexObject, VHLNameUtf8, FieldNameUtf8, Value.RealValue[0]);
+            break;
+        case kVortexDataTypeVector2:
+            bSuccess = VortexSetInputVector2(VortexObject, VHLNameUtf8, FieldNameUtf8, Value.RealValue);
+            break;
+        case kVortexDataTypeVector3:
+            bSuccess = VortexSetInputVector3(VortexObject, VHLNameUtf8, FieldNameUtf8, Value.RealValue);
+            break;
+        case kVortexDataTypeVector4:
+            bSuccess = VortexSetInputVector4(VortexObject, VHLNameUtf8, FieldNameUtf8, Value.RealValue);
+            break;
+        default:
+            break;
+        }
+
+        if (!bSuccess)
+        {
+            LogErrorForVHLFunction("ApplyQueuedVHLInputs", VortexMechanism->MechanismFilepath.FilePath, VortexObject, Track.VHLName, Track.FieldName, kVortexFieldTypeInput, Track.DataType);
+        }
+    }
+}
+
+bool UMechanismComponent::HasQueuedVHLInputs() const
+{
+    for (const FMechanismQueuedInputTrack& Track : QueuedInputTracks)
+    {
+        if (Track.Inputs.Num() > 1 || (Track.Inputs.Num() == 1 && !Track.Inputs[0].bApplied))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool UMechanismComponent::PreValidateVHLFieldHandle(const TCHAR* FunctionName, const FVortexFieldHandle& Handle, EVortexVHLFieldType FieldType, EVortexVHLDataType DataType)
+{
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+    {
+        return false;
+    }
+
+    // The Vortex application must not be used while a step is running on the simulation thread
+    FVortexRuntimeModule::Get().WaitForSimulationStep();
+
+    // The actor name is only built to report an error, these checks run for every field access
+    if (!IsVHLFieldHandleValid(Handle))
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::%s(): Actor \"%s\". The field handle is not resolved or was invalidated when the component was unregistered. Please call \"ResolveVHLField\" again."), FunctionName, *GetNameSafe(GetOwner()));
+        return false;
+    }
+
+    if (Handle.FieldType != FieldType || Handle.DataType != DataType)
+    {
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::%s(): Actor \"%s\": Interface \"%s\" and field \"%s\". The field handle was resolved for another field type or data type."), FunctionName, *GetNameSafe(GetOwner()), UTF8_TO_TCHAR(Handle.GetInterfaceName()), UTF8_TO_TCHAR(Handle.GetFieldName()));
+        return false;
+    }
+
+    return true;
+}
+
+void UMechanismComponent::LogErrorForVHLFieldHandle(const TCHAR* FunctionName, const FVortexFieldHandle& Handle)
+{
+    LogErrorForVHLFunction(FunctionName, VortexMechanism->MechanismFilepath.FilePath, Handle.VortexObject, UTF8_TO_TCHAR(Handle.GetInterfaceName()), UTF8_TO_TCHAR(Handle.GetFieldName()),
+        VortexFieldHandle::ToVortexFieldType(Handle.FieldType), VortexFieldHandle::ToVortexDataType(Handle.DataType));
+}
+
+bool UMechanismComponent::PreValidateVHLFunction(const FString& FunctionName, const FString& FilePath, const FString& VHLName, const FString& FieldName)
+{
+    bool CanCallVHLFunction = true;
+
+    // The Vortex application must not be used while a step is running on the simulation thread
+    FVortexRuntimeModule::Get().WaitForSimulationStep();
+
+    if (!HasBegunPlay())
+    {
+        CanCallVHLFunction = false;
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::%s(): Actor \"%s\", Mechanism \"%s\": Interface \"%s\" and field \"%s\". The component has not begun play yet. Please make sure to call this function only after the \"BeginPlay\" event has been triggered."), *FunctionName, *GetNameSafe(GetOwner()), *FilePath, *VHLName, *FieldName);
+    }
+    else if (bMechanismLoadPending)
     {
         CanCallVHLFunction = false;
-        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::%s(): Actor \"%s\", Mechanism \"%s\": Interface \"%s\" and field \"%s\". The component has not begun play yet. Please make sure to call this function only after the \"BeginPlay\" event has been triggered."), *FunctionName, *ActorName, *FilePath, *VHLName, *FieldName);
+        UE_LOG(LogVortex, Warning, TEXT("UMechanismComponent::%s(): Actor \"%s\", Mechanism \"%s\": Interface \"%s\" and field \"%s\". The associated Vortex Mechanism is still loading. Please wait for the \"OnMechanismLoaded\" event to read it."), *FunctionName, *GetNameSafe(GetOwner()), *FilePath, *VHLName, *FieldName);
     }
     else if (VortexObject == nullptr)
     {
         CanCallVHLFunction = false;
-        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::%s(): Actor \"%s\", Mechanism \"%s\": Interface \"%s\" and field \"%s\". The associated Vortex Mechanism is not loaded. An unknown error occured."), *FunctionName, *ActorName, *FilePath, *VHLName, *FieldName);
+        UE_LOG(LogVortex, Error, TEXT("UMechanismComponent::%s(): Actor \"%s\", Mechanism \"%s\": Interface \"%s\" and field \"%s\". The associated Vortex Mechanism is not loaded. An unknown error occured."), *FunctionName, *GetNameSafe(GetOwner()), *FilePath, *VHLName, *FieldName);
     }
 
     return CanCallVHLFunction;
@@ -3,14 +3,30 @@
 
 #include "VortexIntegration/VortexIntegration.h"
 
-void UVortexApplicationBlueprintLib::StartSimulation(UObject* WorldContextObject)
+void UVortexApplicationBlueprintLib::StartSimulation(UObject* WorldContextObject, float TargetSpeedMultiplier)
 {
     if (!FVortexRuntimeModule::IsIntegrationLoaded())
     {
         return;
     }
 
+    FVortexRuntimeModule::Get().WaitForSimulationStep();
     FVortexRuntimeModule::Get().CurrentWorldContext = WorldContextObject;
+    if (TargetSpeedMultiplier <= 0.0f)
+    {
+        UE_LOG(LogVortex, Warning, TEXT("UVortexApplicationBlueprintLib::StartSimulation(): Invalid target speed multiplier %f, using 1."), TargetSpeedMultiplier);
+        TargetSpeedMultiplier = 1.0f;
+    }
+    FVortexRuntimeModule::Get().TargetSpeedMultiplier = TargetSpeedMultiplier;
+
+    // Mechanisms are loaded in Editing mode, the module starts the simulation once the pending ones are loaded
+    if (FVortexRuntimeModule::Get().GetPendingMechanismLoadCount() > 0)
+    {
+        UE_LOG(LogVortex, Display, TEXT("UVortexApplicationBlueprintLib::StartSimulation(): Starting simulation once %d pending mechanisms are loaded."), FVortexRuntimeModule::Get().GetPendingMechanismLoadCount());
+        FVortexRuntimeModule::Get().bStartSimulationWhenLoaded = true;
+        return;
+    }
+
     UE_LOG(LogVortex, Display, TEXT("UVortexApplicationBlueprintLib::StartSimulation(): Starting simulation."));
     VortexSetApplicationMode(kVortexModeSimulating, true);
 }
@@ -22,8 +38,32 @@ void UVortexApplicationBlueprintLib::StopSimulation(UObject*)
         return;
     }
 
+    FVortexRuntimeModule::Get().WaitForSimulationStep();
+    FVortexRuntimeModule::Get().bStartSimulationWhenLoaded = false;
     VortexSetApplicationMode(kVortexModeEditing, true);
     VortexResetSimulationTime();
     UE_LOG(LogVortex, Display, TEXT("UVortexApplicationBlueprintLib::StopSimulation(): Stopping simulation."));
     FVortexRuntimeModule::Get().CurrentWorldContext = nullptr;
+    FVortexRuntimeModule::Get().TargetSpeedMultiplier = 1.0f;
+}
+
+float UVortexApplicationBlueprintLib::GetRealTimeFactor()
+{
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+    {
+        return 0.0f;
+    }
+
+    return static_cast<float>(FVortexRuntimeModule::Get().GetRealTimeFactor());
+}
+
+float UVortexApplicationBlueprintLib::GetSimulationTime()
+{
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+    {
+        return 0.0f;
+    }
+
+    FVortexRuntimeModule::Get().WaitForSimulationStep();
+    return static_cast<float>(VortexGetSimulationTime());
 }
\ No newline at end of file
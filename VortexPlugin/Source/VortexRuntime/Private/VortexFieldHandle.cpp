@@ -0,0 +1,184 @@
+#include "VortexFieldHandle.h"
+#include "VortexIntegrationUtilities.h"
+
+FVortexFieldHandle::FVortexFieldHandle()
+    : FieldType(EVortexVHLFieldType::Output)
+    , DataType(EVortexVHLDataType::Float)
+    , VortexObject(nullptr)
+    , Generation(0)
+{
+}
+
+FVortexVHLValue::FVortexVHLValue()
+    : Boolean(false)
+    , Integer(0)
+    , Float(0.0f)
+    , Vector2(FVector2D::ZeroVector)
+    , Vector3(FVector::ZeroVector)
+    , Vector4(0.0f, 0.0f, 0.0f, 0.0f)
+    , Transform(FTransform::Identity)
+{
+}
+
+bool FVortexFieldHandle::WriteInput(const FVortexVHLBatchValues& Values, int32 Index) const
+{
+    bool bSuccess = false;
+    switch (DataType)
+    {
+    case EVortexVHLDataType::Boolean:
+        bSuccess = VortexSetInputBoolean(VortexObject, GetInterfaceName(), GetFieldName(), Values.Booleans[Index]);
+        break;
+    case EVortexVHLDataType::Integer:
+        bSuccess = VortexSetInputInt(VortexObject, GetInterfaceName(), GetFieldName(), Values.Integers[Index]);
+        break;
+    case EVortexVHLDataType::Float:
+        bSuccess = VortexSetInputReal(VortexObject, GetInterfaceName(), GetFieldName(), Values.Floats[Index]);
+        break;
+    case EVortexVHLDataType::Vector2:
+    {
+        const FVector2D& Value = Values.Vectors2[Index];
+        double VxValue[2] = { Value.X, Value.Y };
+        bSuccess = VortexSetInputVector2(VortexObject, GetInterfaceName(), GetFieldName(), VxValue);
+        break;
+    }
+    case EVortexVHLDataType::Vector3:
+    {
+        const FVector& Value = Values.Vectors3[Index];
+        double VxValue[3] = { Value.X, Value.Y, Value.Z };
+        bSuccess = VortexSetInputVector3(VortexObject, GetInterfaceName(), GetFieldName(), VxValue);
+        break;
+    }
+    case EVortexVHLDataType::Vector4:
+    {
+        const FVector4& Value = Values.Vectors4[Index];
+        double VxValue[4] = { Value.X, Value.Y, Value.Z, Value.W };
+        bSuccess = VortexSetInputVector4(VortexObject, GetInterfaceName(), GetFieldName(), VxValue);
+        break;
+    }
+    case EVortexVHLDataType::Transform:
+    {
+        double Translation[3];
+        double Rotation[4];
+        VortexIntegrationUtilities::ConvertTransform(Values.Transforms[Index], Translation, Rotation);
+        bSuccess = VortexSetInputMatrix(VortexObject, GetInterfaceName(), GetFieldName(), Translation, Rotation);
+        break;
+    }
+    default:
+        break;
+    }
+
+    return bSuccess;
+}
+
+bool FVortexFieldHandle::ReadOutput(FVortexVHLBatchValues& Values, int32 Index) const
+{
+    bool bSuccess = false;
+    switch (DataType)
+    {
+    case EVortexVHLDataType::Boolean:
+        bSuccess = VortexGetOutputBoolean(VortexObject, GetInterfaceName(), GetFieldName(), &Values.Booleans[Index]);
+        break;
+    case EVortexVHLDataType::Integer:
+        bSuccess = VortexGetOutputInt(VortexObject, GetInterfaceName(), GetFieldName(), &Values.Integers[Index]);
+        break;
+    case EVortexVHLDataType::Float:
+    {
+        double VxValue;
+        bSuccess = VortexGetOutputReal(VortexObject, GetInterfaceName(), GetFieldName(), &VxValue);
+        Values.Floats[Index] = bSuccess ? VxValue : Values.Floats[Index];
+        break;
+    }
+    case EVortexVHLDataType::Vector2:
+    {
+        double VxValue[2];
+        bSuccess = VortexGetOutputVector2(VortexObject, GetInterfaceName(), GetFieldName(), VxValue);
+        Values.Vectors2[Index] = bSuccess ? FVector2D(VxValue[0], VxValue[1]) : Values.Vectors2[Index];
+        break;
+    }
+    case EVortexVHLDataType::Vector3:
+    {
+        double VxValue[3];
+        bSuccess = VortexGetOutputVector3(VortexObject, GetInterfaceName(), GetFieldName(), VxValue);
+        Values.Vectors3[Index] = bSuccess ? FVector(VxValue[0], VxValue[1], VxValue[2]) : Values.Vectors3[Index];
+        break;
+    }
+    case EVortexVHLDataType::Vector4:
+    {
+        double VxValue[4];
+        bSuccess = VortexGetOutputVector4(VortexObject, GetInterfaceName(), GetFieldName(), VxValue);
+        Values.Vectors4[Index] = bSuccess ? FVector4(VxValue[0], VxValue[1], VxValue[2], VxValue[3]) : Values.Vectors4[Index];
+        break;
+    }
+    case EVortexVHLDataType::Transform:
+    {
+        double Translation[3];
+        double Rotation[4];
+        bSuccess = VortexGetOutputMatrix(VortexObject, GetInterfaceName(), GetFieldName(), Translation, Rotation);
+        Values.Transforms[Index] = bSuccess ? VortexIntegrationUtilities::ConvertTransform(Translation, Rotation) : Values.Transforms[Index];
+        break;
+    }
+    default:
+        break;
+    }
+
+    return bSuccess;
+}
+
+void FVortexVHLBatchValues::Allocate(const TArray<FVortexFieldHandle>& Fields)
+{
+    int32 Counts[static_cast<int32>(EVortexVHLDataType::Transform) + 1] = {};
+    for (const FVortexFieldHandle& Field : Fields)
+    {
+        ++Counts[static_cast<int32>(Field.DataType)];
+    }
+
+    Booleans.SetNumZeroed(Counts[static_cast<int32>(EVortexVHLDataType::Boolean)]);
+    Integers.SetNumZeroed(Counts[static_cast<int32>(EVortexVHLDataType::Integer)]);
+    Floats.SetNumZeroed(Counts[static_cast<int32>(EVortexVHLDataType::Float)]);
+    Vectors2.SetNumZeroed(Counts[static_cast<int32>(EVortexVHLDataType::Vector2)]);
+    Vectors3.SetNumZeroed(Counts[static_cast<int32>(EVortexVHLDataType::Vector3)]);
+    Vectors4.SetNumZeroed(Counts[static_cast<int32>(EVortexVHLDataType::Vector4)]);
+    Transforms.Init(FTransform::Identity, Counts[static_cast<int32>(EVortexVHLDataType::Transform)]);
+}
+
+bool FVortexVHLBatchValues::HasSameLayout(const FVortexVHLBatchValues& Other) const
+{
+    return Booleans.Num() == Other.Booleans.Num()
+        && Integers.Num() == Other.Integers.Num()
+        && Floats.Num() == Other.Floats.Num()
+        && Vectors2.Num() == Other.Vectors2.Num()
+        && Vectors3.Num() == Other.Vectors3.Num()
+        && Vectors4.Num() == Other.Vectors4.Num()
+        && Transforms.Num() == Other.Transforms.Num();
+}
+
+namespace VortexFieldHandle
+{
+    VortexDataType ToVortexDataType(EVortexVHLDataType DataType)
+    {
+        switch (DataType)
+        {
+        case EVortexVHLDataType::Boolean:
+            return kVortexDataTypeBoolean;
+        case EVortexVHLDataType::Integer:
+            return kVortexDataTypeInt;
+        case EVortexVHLDataType::Float:
+            return kVortexDataTypeReal;
+        case EVortexVHLDataType::Vector2:
+            return kVortexDataTypeVector2;
+        case EVortexVHLDataType::Vector3:
+            return kVortexDataTypeVector3;
+        case EVortexVHLDataType::Vector4:
+            return kVortexDataTypeVector4;
+        case EVortexVHLDataType::Transform:
+            return kVortexDataTypeMatrix;
+        default:
+            return kVortexDataTypeUnknown;
+        }
+    }
+
+    VortexFieldType ToVortexFieldType(EVortexVHLFieldType FieldType)
+    {
+        return FieldType == EVortexVHLFieldType::Input ? kVortexFieldTypeInput : kVortexFieldTypeOutput;
+    }
+}
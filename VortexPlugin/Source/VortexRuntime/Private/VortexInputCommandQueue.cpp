@@ -0,0 +1,148 @@
+#include "VortexInputCommandQueue.h"
+#include "VortexIntegrationUtilities.h"
+#include "VortexRuntime.h"
+
+DECLARE_CYCLE_STAT(TEXT("DrainInputCommands"), STAT_DrainInputCommands, STATGROUP_VortexRuntimeModule);
+
+FVortexInputCommandQueue::FVortexInputCommandQueue(VortexObjectHandle InVortexObject, uint32 InGeneration)
+    : bBound(true)
+    , VortexObject(InVortexObject)
+    , Generation(InGeneration)
+{
+}
+
+bool FVortexInputCommandQueue::Accepts(const FVortexFieldHandle& Handle) const
+{
+    return VortexObject != nullptr && Handle.VortexObject == VortexObject && Handle.Generation == Generation;
+}
+
+bool FVortexInputCommandQueue::Push(const FVortexFieldHandle& Handle, bool Value)
+{
+    FVortexInputCommand Command = {};
+    Command.Handle = Handle;
+    Command.IntegerValue = Value ? 1 : 0;
+    return Push(MoveTemp(Command), EVortexVHLDataType::Boolean);
+}
+
+bool FVortexInputCommandQueue::Push(const FVortexFieldHandle& Handle, int32 Value)
+{
+    FVortexInputCommand Command = {};
+    Command.Handle = Handle;
+    Command.IntegerValue = Value;
+    return Push(MoveTemp(Command), EVortexVHLDataType::Integer);
+}
+
+bool FVortexInputCommandQueue::Push(const FVortexFieldHandle& Handle, double Value)
+{
+    FVortexInputCommand Command = {};
+    Command.Handle = Handle;
+    Command.RealValue[0] = Value;
+    return Push(MoveTemp(Command), EVortexVHLDataType::Float);
+}
+
+bool FVortexInputCommandQueue::Push(const FVortexFieldHandle& Handle, const FVector2D& Value)
+{
+    FVortexInputCommand Command = {};
+    Command.Handle = Handle;
+    Command.RealValue[0] = Value.X;
+    Command.RealValue[1] = Value.Y;
+    return Push(MoveTemp(Command), EVortexVHLDataType::Vector2);
+}
+
+bool FVortexInputCommandQueue::Push(const FVortexFieldHandle& Handle, const FVector& Value)
+{
+    FVortexInputCommand Command = {};
+    Command.Handle = Handle;
+    Command.RealValue[0] = Value.X;
+    Command.RealValue[1] = Value.Y;
+    Command.RealValue[2] = Value.Z;
+    return Push(MoveTemp(Command), EVortexVHLDataType::Vector3);
+}
+
+bool FVortexInputCommandQueue::Push(const FVortexFieldHandle& Handle, const FVector4& Value)
+{
+    FVortexInputCommand Command = {};
+    Command.Handle = Handle;
+    Command.RealValue[0] = Value.X;
+    Command.RealValue[1] = Value.Y;
+    Command.RealValue[2] = Value.Z;
+    Command.RealValue[3] = Value.W;
+    return Push(MoveTemp(Command), EVortexVHLDataType::Vector4);
+}
+
+bool FVortexInputCommandQueue::Push(const FVortexFieldHandle& Handle, const FTransform& Value)
+{
+    FVortexInputCommand Command = {};
+    Command.Handle = Handle;
+    Command.Transform = Value;
+    return Push(MoveTemp(Command), EVortexVHLDataType::Transform);
+}
+
+bool FVortexInputCommandQueue::Push(FVortexInputCommand&& Command, EVortexVHLDataType DataType)
+{
+    if (!bBound || !Accepts(Command.Handle) || Command.Handle.FieldType != EVortexVHLFieldType::Input || Command.Handle.DataType != DataType)
+    {
+        return false;
+    }
+
+    return Commands.Enqueue(MoveTemp(Command));
+}
+
+void FVortexInputCommandQueue::Drain()
+{
+    SCOPE_CYCLE_COUNTER(STAT_DrainInputCommands);
+    FVortexInputCommand Command;
+    while (Commands.Dequeue(Command))
+    {
+        // The mechanism may have been unloaded since the push, Unbind() then drops the commands
+        const FVortexFieldHandle& Handle = Command.Handle;
+        if (!bBound || !Accepts(Handle))
+        {
+            continue;
+        }
+
+        bool bSuccess = false;
+        switch (Handle.DataType)
+        {
+        case EVortexVHLDataType::Boolean:
+            bSuccess = VortexSetInputBoolean(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Command.IntegerValue != 0);
+            break;
+        case EVortexVHLDataType::Integer:
+            bSuccess = VortexSetInputInt(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Command.IntegerValue);
+            break;
+        case EVortexVHLDataType::Float:
+            bSuccess = VortexSetInputReal(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Command.RealValue[0]);
+            break;
+        case EVortexVHLDataType::Vector2:
+            bSuccess = VortexSetInputVector2(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Command.RealValue);
+            break;
+        case EVortexVHLDataType::Vector3:
+            bSuccess = VortexSetInputVector3(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Command.RealValue);
+            break;
+        case EVortexVHLDataType::Vector4:
+            bSuccess = VortexSetInputVector4(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Command.RealValue);
+            break;
+        case EVortexVHLDataType::Transform:
+        {
+            double Translation[3];
+            double Rotation[4];
+            VortexIntegrationUtilities::ConvertTransform(Command.Transform, Translation, Rotation);
+            bSuccess = VortexSetInputMatrix(Handle.VortexObject, Handle.GetInterfaceName(), Handle.GetFieldName(), Translation, Rotation);
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (!bSuccess)
+        {
+            UE_LOG(LogVortex, Error, TEXT("FVortexInputCommandQueue::Drain(): Interface \"%s\" and field \"%s\". The input could not be set."), UTF8_TO_TCHAR(Handle.GetInterfaceName()), UTF8_TO_TCHAR(Handle.GetFieldName()));
+        }
+    }
+}
+
+void FVortexInputCommandQueue::Unbind()
+{
+    bBound = false;
+    Commands.Empty();
+}
@@ -1,11 +1,108 @@
 #include "VortexIntegrationUtilities.h"
+#include "VortexRuntime.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
 
 #include <algorithm>
 
+// Conversions from double arrays use SSE2 directly, UE4 vector registers only hold floats
+#define VORTEX_SSE2_CONVERSIONS (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY)
+
+#if VORTEX_SSE2_CONVERSIONS
+#include <emmintrin.h>
+#endif
+
 namespace
 {
     const double kMToCm = 100.0f;
     const double kCmToM = 1.0f / kMToCm;
+
+    static_assert(sizeof(FVector) == 3 * sizeof(float), "Array conversions write FVector arrays as packed floats");
+
+    // 4 vectors of 3 coordinates fill 3 registers of 4 floats, the factors repeat every 3 lanes
+    const int32 kBatchWidth = 4;
+
+#if VORTEX_SSE2_CONVERSIONS
+    FORCEINLINE __m128 LoadDoubles(const double* Values)
+    {
+        return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(Values)), _mm_cvtpd_ps(_mm_loadu_pd(Values + 2)));
+    }
+
+    FORCEINLINE void StoreDoubles(__m128 Vector, double* Values)
+    {
+        _mm_storeu_pd(Values, _mm_cvtps_pd(Vector));
+        _mm_storeu_pd(Values + 2, _mm_cvtps_pd(_mm_movehl_ps(Vector, Vector)));
+    }
+#endif
+
+    // Multiplies each coordinate of Count packed vectors by the matching coordinate of Factors
+    void ScaleVectors(const float* In, int32 Count, const FVector& Factors, float* Out)
+    {
+        const VectorRegister Factors0 = MakeVectorRegister(Factors.X, Factors.Y, Factors.Z, Factors.X);
+        const VectorRegister Factors1 = MakeVectorRegister(Factors.Y, Factors.Z, Factors.X, Factors.Y);
+        const VectorRegister Factors2 = MakeVectorRegister(Factors.Z, Factors.X, Factors.Y, Factors.Z);
+
+        int32 i = 0;
+        for (; i + kBatchWidth <= Count; i += kBatchWidth)
+        {
+            VectorStore(VectorMultiply(VectorLoad(In + i * 3), Factors0), Out + i * 3);
+            VectorStore(VectorMultiply(VectorLoad(In + i * 3 + 4), Factors1), Out + i * 3 + 4);
+            VectorStore(VectorMultiply(VectorLoad(In + i * 3 + 8), Factors2), Out + i * 3 + 8);
+        }
+
+        for (; i < Count; ++i)
+        {
+            Out[i * 3] = In[i * 3] * Factors.X;
+            Out[i * 3 + 1] = In[i * 3 + 1] * Factors.Y;
+            Out[i * 3 + 2] = In[i * 3 + 2] * Factors.Z;
+        }
+    }
+
+    void ScaleVectors(const double* In, int32 Count, const FVector& Factors, float* Out)
+    {
+        int32 i = 0;
+#if VORTEX_SSE2_CONVERSIONS
+        const __m128 Factors0 = _mm_setr_ps(Factors.X, Factors.Y, Factors.Z, Factors.X);
+        const __m128 Factors1 = _mm_setr_ps(Factors.Y, Factors.Z, Factors.X, Factors.Y);
+        const __m128 Factors2 = _mm_setr_ps(Factors.Z, Factors.X, Factors.Y, Factors.Z);
+        for (; i + kBatchWidth <= Count; i += kBatchWidth)
+        {
+            _mm_storeu_ps(Out + i * 3, _mm_mul_ps(LoadDoubles(In + i * 3), Factors0));
+            _mm_storeu_ps(Out + i * 3 + 4, _mm_mul_ps(LoadDoubles(In + i * 3 + 4), Factors1));
+            _mm_storeu_ps(Out + i * 3 + 8, _mm_mul_ps(LoadDoubles(In + i * 3 + 8), Factors2));
+        }
+#endif
+
+        for (; i < Count; ++i)
+        {
+            Out[i * 3] = static_cast<float>(In[i * 3] * Factors.X);
+            Out[i * 3 + 1] = static_cast<float>(In[i * 3 + 1] * Factors.Y);
+            Out[i * 3 + 2] = static_cast<float>(In[i * 3 + 2] * Factors.Z);
+        }
+    }
+
+    void ScaleVectors(const float* In, int32 Count, const FVector& Factors, double* Out)
+    {
+        int32 i = 0;
+#if VORTEX_SSE2_CONVERSIONS
+        const __m128 Factors0 = _mm_setr_ps(Factors.X, Factors.Y, Factors.Z, Factors.X);
+        const __m128 Factors1 = _mm_setr_ps(Factors.Y, Factors.Z, Factors.X, Factors.Y);
+        const __m128 Factors2 = _mm_setr_ps(Factors.Z, Factors.X, Factors.Y, Factors.Z);
+        for (; i + kBatchWidth <= Count; i += kBatchWidth)
+        {
+            StoreDoubles(_mm_mul_ps(_mm_loadu_ps(In + i * 3), Factors0), Out + i * 3);
+            StoreDoubles(_mm_mul_ps(_mm_loadu_ps(In + i * 3 + 4), Factors1), Out + i * 3 + 4);
+            StoreDoubles(_mm_mul_ps(_mm_loadu_ps(In + i * 3 + 8), Factors2), Out + i * 3 + 8);
+        }
+#endif
+
+        for (; i < Count; ++i)
+        {
+            Out[i * 3] = In[i * 3] * Factors.X;
+            Out[i * 3 + 1] = In[i * 3 + 1] * Factors.Y;
+            Out[i * 3 + 2] = In[i * 3 + 2] * Factors.Z;
+        }
+    }
 }
 
 namespace VortexIntegrationUtilities
@@ -94,4 +191,176 @@ namespace VortexIntegrationUtilities
         //
         return FQuat(-RotationQuaternion[1], RotationQuaternion[2], -RotationQuaternion[3], RotationQuaternion[0]);
     }
+
+    void ConvertTranslations(const float* Translations, int32 Count, FVector* Out)
+    {
+        ScaleVectors(Translations, Count, FVector(kMToCm, -kMToCm, kMToCm), reinterpret_cast<float*>(Out));
+    }
+
+    void ConvertTranslations(const double* Translations, int32 Count, FVector* Out)
+    {
+        ScaleVectors(Translations, Count, FVector(kMToCm, -kMToCm, kMToCm), reinterpret_cast<float*>(Out));
+    }
+
+    void ConvertTranslations(const FVector* UnrealVectors, int32 Count, const FVector& Scale, double* Translations)
+    {
+        ScaleVectors(reinterpret_cast<const float*>(UnrealVectors), Count, Scale * FVector(kCmToM, -kCmToM, kCmToM), Translations);
+    }
+
+    void ConvertDirections(const float* Directions, int32 Count, FVector* Out)
+    {
+        ScaleVectors(Directions, Count, FVector(1.0f, -1.0f, 1.0f), reinterpret_cast<float*>(Out));
+    }
+
+    void ConvertDirections(const double* Directions, int32 Count, FVector* Out)
+    {
+        ScaleVectors(Directions, Count, FVector(1.0f, -1.0f, 1.0f), reinterpret_cast<float*>(Out));
+    }
+
+    void ConvertRotations(const double* RotationQuaternions, int32 Count, FQuat* Out)
+    {
+        int32 i = 0;
+#if VORTEX_SSE2_CONVERSIONS
+        // Same as ConvertRotation(): (w, x, y, z) becomes (-x, y, -z, w)
+        const __m128 Signs = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+        for (; i < Count; ++i)
+        {
+            const __m128 WXYZ = LoadDoubles(RotationQuaternions + i * 4);
+            _mm_storeu_ps(&Out[i].X, _mm_mul_ps(_mm_shuffle_ps(WXYZ, WXYZ, _MM_SHUFFLE(0, 3, 2, 1)), Signs));
+        }
+#endif
+
+        for (; i < Count; ++i)
+        {
+            Out[i] = ConvertRotation(RotationQuaternions + i * 4);
+        }
+    }
+
+    void ConvertTransforms(const double* Translations, const double* Scales, const double* RotationQuaternions, int32 Count, FTransform* Out)
+    {
+        // Converted by chunks on the stack, then assembled
+        const int32 ChunkSize = 64;
+        FVector ChunkTranslations[ChunkSize];
+        FVector ChunkScales[ChunkSize];
+        FQuat ChunkRotations[ChunkSize];
+        for (int32 Start = 0; Start < Count; Start += ChunkSize)
+        {
+            const int32 ChunkCount = FMath::Min(ChunkSize, Count - Start);
+            ConvertTranslations(Translations + Start * 3, ChunkCount, ChunkTranslations);
+            ScaleVectors(Scales + Start * 3, ChunkCount, FVector::OneVector, reinterpret_cast<float*>(ChunkScales));
+            ConvertRotations(RotationQuaternions + Start * 4, ChunkCount, ChunkRotations);
+            for (int32 i = 0; i < ChunkCount; ++i)
+            {
+                Out[Start + i] = FTransform(ChunkRotations[i], ChunkTranslations[i], ChunkScales[i]);
+            }
+        }
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+    // Times the single element conversions, as the bulk paths used to call them, against the array conversions
+    void BenchmarkConversions(const TArray<FString>& Args)
+    {
+        const int32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+        const int32 Iterations = 20;
+
+        TArray<float> Floats;
+        TArray<double> Doubles;
+        TArray<double> Quaternions;
+        Floats.SetNumUninitialized(Count * 3);
+        Doubles.SetNumUninitialized(Count * 3);
+        Quaternions.SetNumUninitialized(Count * 4);
+        for (int32 i = 0; i < Count * 3; ++i)
+        {
+            Floats[i] = FMath::FRandRange(-100.0f, 100.0f);
+            Doubles[i] = Floats[i];
+        }
+        for (int32 i = 0; i < Count; ++i)
+        {
+            const FQuat Rotation = FRotator(FMath::FRandRange(-180.0f, 180.0f), FMath::FRandRange(-180.0f, 180.0f), FMath::FRandRange(-180.0f, 180.0f)).Quaternion();
+            VortexIntegrationUtilities::ConvertRotation(Rotation, &Quaternions[i * 4]);
+        }
+
+        TArray<FVector> Vectors;
+        TArray<FQuat> Rotations;
+        TArray<double> Exported;
+        Vectors.SetNumUninitialized(Count);
+        Rotations.SetNumUninitialized(Count);
+        Exported.SetNumUninitialized(Count * 3);
+
+        auto Time = [Iterations](const TFunctionRef<void()>& Run)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                Run();
+            }
+            return (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+        };
+
+        auto Report = [Count](const TCHAR* Name, double ElementTime, double ArrayTime)
+        {
+            UE_LOG(LogVortex, Display, TEXT("Vortex.BenchmarkConversions: %s x %d: %.3f ms per element, %.3f ms as an array (%.1fx)."), Name, Count, ElementTime, ArrayTime, ArrayTime > 0.0 ? ElementTime / ArrayTime : 0.0);
+        };
+
+        Report(TEXT("ConvertTranslations (float)"),
+            Time([&]()
+            {
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    double Translation[3] = { Floats[i * 3], Floats[i * 3 + 1], Floats[i * 3 + 2] };
+                    Vectors[i] = VortexIntegrationUtilities::ConvertTranslation(Translation);
+                }
+            }),
+            Time([&]() { VortexIntegrationUtilities::ConvertTranslations(Floats.GetData(), Count, Vectors.GetData()); }));
+
+        Report(TEXT("ConvertTranslations (double)"),
+            Time([&]()
+            {
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    Vectors[i] = VortexIntegrationUtilities::ConvertTranslation(&Doubles[i * 3]);
+                }
+            }),
+            Time([&]() { VortexIntegrationUtilities::ConvertTranslations(Doubles.GetData(), Count, Vectors.GetData()); }));
+
+        Report(TEXT("ConvertTranslations (to Vortex)"),
+            Time([&]()
+            {
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    VortexIntegrationUtilities::ConvertTranslation(Vectors[i] * FVector::OneVector, &Exported[i * 3]);
+                }
+            }),
+            Time([&]() { VortexIntegrationUtilities::ConvertTranslations(Vectors.GetData(), Count, FVector::OneVector, Exported.GetData()); }));
+
+        Report(TEXT("ConvertDirections (float)"),
+            Time([&]()
+            {
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    double Direction[3] = { Floats[i * 3], Floats[i * 3 + 1], Floats[i * 3 + 2] };
+                    Vectors[i] = VortexIntegrationUtilities::ConvertDirection(Direction);
+                }
+            }),
+            Time([&]() { VortexIntegrationUtilities::ConvertDirections(Floats.GetData(), Count, Vectors.GetData()); }));
+
+        Report(TEXT("ConvertRotations"),
+            Time([&]()
+            {
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    Rotations[i] = VortexIntegrationUtilities::ConvertRotation(&Quaternions[i * 4]);
+                }
+            }),
+            Time([&]() { VortexIntegrationUtilities::ConvertRotations(Quaternions.GetData(), Count, Rotations.GetData()); }));
+    }
+
+    FAutoConsoleCommand BenchmarkConversionsCommand(
+        TEXT("Vortex.BenchmarkConversions"),
+        TEXT("Times the single element and the array coordinate conversions. Optional argument: the number of elements (default 100000)."),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkConversions));
 }
+#endif
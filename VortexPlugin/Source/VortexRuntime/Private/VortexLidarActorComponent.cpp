@@ -266,16 +266,14 @@ void UVortexLidarActorComponent::visualizePointCloud(const float* inLastFullScan
 {
     if (PointCloudVisualization && !OutputAsDistanceField && inLastFullScan != nullptr)
     {
-        for (int i = 0; i < HorizontalResolution * NumberOfChannels; ++i)
+        TArray<FVector> lPoints;
+        lPoints.SetNumUninitialized(HorizontalResolution * NumberOfChannels);
+        VortexIntegrationUtilities::ConvertTranslations(inLastFullScan, lPoints.Num(), lPoints.GetData());
+        for (int i = 0; i < lPoints.Num(); ++i)
         {
-            double vortexTranslation[3];
-            vortexTranslation[0] = static_cast<double>(inLastFullScan[i * 3 + 0]);
-            vortexTranslation[1] = static_cast<double>(inLastFullScan[i * 3 + 1]);
-            vortexTranslation[2] = static_cast<double>(inLastFullScan[i * 3 + 2]);
-            FVector lPoint = VortexIntegrationUtilities::ConvertTranslation(vortexTranslation);
             DrawDebugPoint(
                 GetWorld(),
-                lPoint,
+                lPoints[i],
                 5,
                 i == 0 ? FColor::Red : FColor::Blue,
                 true
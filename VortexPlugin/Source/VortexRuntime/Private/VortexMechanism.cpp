@@ -15,8 +15,14 @@ void UVortexMechanism::PostLoad()
         FPaths::MakePathRelativeTo(MechanismFilepath.FilePath, *FPaths::ProjectContentDir());
         filepath_DEPRECATED.Empty();
     }
+    UpdateMechanismFilepathName();
     Super::PostLoad();
 }
+
+void UVortexMechanism::UpdateMechanismFilepathName()
+{
+    MechanismFilepathName = FName(*MechanismFilepath.FilePath);
+}
 #if WITH_EDITOR
 void UVortexMechanism::PostEditChangeProperty(struct FPropertyChangedEvent& e)
 {
@@ -25,6 +31,8 @@ void UVortexMechanism::PostEditChangeProperty(struct FPropertyChangedEvent& e)
     {
         FPaths::MakePathRelativeTo(MechanismFilepath.FilePath, *FPaths::ProjectContentDir());
     }
+    // Undoing an edit comes without the changed property
+    UpdateMechanismFilepathName();
     Super::PostEditChangeProperty(e);
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "VortexMechanismInstancer.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "EngineUtils.h"
+#include "MechanismComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlushInstances"), STAT_FlushInstances, STATGROUP_VortexMechanism);
+DECLARE_DWORD_COUNTER_STAT(TEXT("InstancedGraphicNodes"), STAT_InstancedGraphicNodes, STATGROUP_VortexMechanism);
+
+AVortexMechanismInstancer::AVortexMechanismInstancer()
+{
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+AVortexMechanismInstancer* AVortexMechanismInstancer::Find(UWorld* World)
+{
+    if (World != nullptr)
+    {
+        for (TActorIterator<AVortexMechanismInstancer> It(World); It; ++It)
+        {
+            return *It;
+        }
+    }
+
+    return nullptr;
+}
+
+AVortexMechanismInstancer* AVortexMechanismInstancer::Get(UWorld* World)
+{
+    if (World == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (AVortexMechanismInstancer* Instancer = Find(World))
+    {
+        return Instancer;
+    }
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.ObjectFlags |= RF_Transient;
+    return World->SpawnActor<AVortexMechanismInstancer>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParameters);
+}
+
+bool AVortexMechanismInstancer::CanInstance(const UStaticMeshComponent* Twin)
+{
+    // Attached children would no longer follow the twin, which does not move once instanced
+    return Twin != nullptr && Twin->GetStaticMesh() != nullptr && !Twin->IsA<UInstancedStaticMeshComponent>() && Twin->GetAttachChildren().Num() == 0;
+}
+
+UHierarchicalInstancedStaticMeshComponent* AVortexMechanismInstancer::AddInstance(UStaticMeshComponent* Twin, UMechanismComponent* Owner, int32 TwinIndex, int32& Index)
+{
+    FVortexInstancedMeshKey Key;
+    Key.Mesh = Twin->GetStaticMesh();
+    for (int32 i = 0; i < Twin->GetNumMaterials(); ++i)
+    {
+        Key.Materials.Add(Twin->GetMaterial(i));
+    }
+
+    FInstancedMesh* InstancedMesh = InstancedMeshes.Find(Key);
+    if (InstancedMesh == nullptr)
+    {
+        UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(this);
+        Component->SetupAttachment(RootComponent);
+        Component->SetMobility(EComponentMobility::Movable);
+        Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        Component->SetStaticMesh(Key.Mesh);
+        for (int32 i = 0; i < Key.Materials.Num(); ++i)
+        {
+            Component->SetMaterial(i, Key.Materials[i]);
+        }
+        Component->SetCastShadow(Twin->CastShadow);
+        Component->RegisterComponent();
+
+        InstancedMesh = &InstancedMeshes.Add(Key);
+        InstancedMesh->Component = Component;
+        InstancedMesh->DirtyStart = MAX_int32;
+        InstancedMesh->DirtyEnd = 0;
+    }
+
+    const FTransform& Transform = Twin->GetComponentTransform();
+    Index = InstancedMesh->Component->AddInstanceWorldSpace(Transform);
+    InstancedMesh->Transforms.Add(Transform);
+    InstancedMesh->Owners.Emplace(Owner, TwinIndex);
+    check(InstancedMesh->Transforms.Num() == InstancedMesh->Component->GetInstanceCount());
+
+    return InstancedMesh->Component;
+}
+
+void AVortexMechanismInstancer::RemoveInstance(UHierarchicalInstancedStaticMeshComponent* Component, int32 Index)
+{
+    FInstancedMesh* InstancedMesh = FindInstancedMesh(Component);
+    if (InstancedMesh == nullptr || !InstancedMesh->Transforms.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    // Flush first, so the removal does not move a stale transform
+    Flush();
+
+    // Removing an instance moves the last one in its place
+    Component->RemoveInstance(Index);
+    InstancedMesh->Transforms.RemoveAtSwap(Index);
+    InstancedMesh->Owners.RemoveAtSwap(Index);
+    if (InstancedMesh->Owners.IsValidIndex(Index))
+    {
+        if (UMechanismComponent* MovedOwner = InstancedMesh->Owners[Index].Key.Get())
+        {
+            MovedOwner->OnGraphicNodeInstanceMoved(InstancedMesh->Owners[Index].Value, Index);
+        }
+    }
+}
+
+bool AVortexMechanismInstancer::SetInstanceTransform(UHierarchicalInstancedStaticMeshComponent* Component, int32 Index, const FTransform& Transform, float Tolerance)
+{
+    FInstancedMesh* InstancedMesh = FindInstancedMesh(Component);
+    if (InstancedMesh == nullptr || !InstancedMesh->Transforms.IsValidIndex(Index) || InstancedMesh->Transforms[Index].Equals(Transform, Tolerance))
+    {
+        return false;
+    }
+
+    InstancedMesh->Transforms[Index] = Transform;
+    InstancedMesh->DirtyStart = FMath::Min(InstancedMesh->DirtyStart, Index);
+    InstancedMesh->DirtyEnd = FMath::Max(InstancedMesh->DirtyEnd, Index + 1);
+    return true;
+}
+
+void AVortexMechanismInstancer::Flush()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlushInstances);
+    for (auto& pair : InstancedMeshes)
+    {
+        FInstancedMesh& InstancedMesh = pair.Value;
+        if (InstancedMesh.DirtyStart >= InstancedMesh.DirtyEnd)
+        {
+            continue;
+        }
+
+        // One render state update for all the instances modified this frame
+        FlushTransforms.Reset();
+        FlushTransforms.Append(InstancedMesh.Transforms.GetData() + InstancedMesh.DirtyStart, InstancedMesh.DirtyEnd - InstancedMesh.DirtyStart);
+        InstancedMesh.Component->BatchUpdateInstancesTransforms(InstancedMesh.DirtyStart, FlushTransforms, true, true, true);
+        InstancedMesh.DirtyStart = MAX_int32;
+        InstancedMesh.DirtyEnd = 0;
+    }
+}
+
+void AVortexMechanismInstancer::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+    Flush();
+
+    // Flush() also runs on demand during the frame, the instances are counted once here
+    for (const auto& pair : InstancedMeshes)
+    {
+        INC_DWORD_STAT_BY(STAT_InstancedGraphicNodes, pair.Value.Transforms.Num());
+    }
+}
+
+AVortexMechanismInstancer::FInstancedMesh* AVortexMechanismInstancer::FindInstancedMesh(UHierarchicalInstancedStaticMeshComponent* Component)
+{
+    for (auto& pair : InstancedMeshes)
+    {
+        if (pair.Value.Component == Component)
+        {
+            return &pair.Value;
+        }
+    }
+
+    return nullptr;
+}
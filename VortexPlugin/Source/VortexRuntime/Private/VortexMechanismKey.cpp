@@ -0,0 +1,30 @@
+#include "VortexMechanismKey.h"
+#include "MechanismComponent.h"
+#include "VortexMechanism.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+FMechanismKey::FMechanismKey()
+{
+}
+
+FMechanismKey::FMechanismKey(const UMechanismComponent* InComponent)
+{
+    if (InComponent == nullptr || InComponent->VortexMechanism == nullptr)
+    {
+        return;
+    }
+
+    const UWorld* world = InComponent->GetWorld();
+    const AActor* actor = InComponent->GetOwner();
+    if (world == nullptr || actor == nullptr)
+    {
+        return;
+    }
+
+    // Names are compared by index, building a key does not format or hash any string
+    World = world->GetFName();
+    Actor = actor->GetFName();
+    Component = InComponent->GetFName();
+    MechanismFilepath = InComponent->VortexMechanism->GetMechanismFilepathName();
+}
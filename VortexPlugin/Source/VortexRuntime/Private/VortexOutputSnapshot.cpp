@@ -0,0 +1,75 @@
+#include "VortexOutputSnapshot.h"
+#include "VortexIntegrationUtilities.h"
+#include "VortexRuntime.h"
+
+DECLARE_CYCLE_STAT(TEXT("PublishOutputSnapshot"), STAT_PublishOutputSnapshot, STATGROUP_VortexRuntimeModule);
+
+FVortexOutputSnapshot::FVortexOutputSnapshot()
+    : Frame(0)
+    , SimulationTime(0.0)
+{
+}
+
+FVortexOutputSnapshotChannel::FVortexOutputSnapshotChannel(const TArray<FVortexFieldHandle>& InOutputs, const TArray<VortexObjectHandle>& InGraphicNodes)
+    : Outputs(InOutputs)
+    , GraphicNodes(InGraphicNodes)
+    , WriteIndex(0)
+    , ReadIndex(1)
+    , SharedIndex(2)
+    , bBound(true)
+{
+    for (FVortexOutputSnapshot& Buffer : Buffers)
+    {
+        Buffer.Outputs.Allocate(Outputs);
+        Buffer.GraphicNodeTransforms.Init(FTransform::Identity, GraphicNodes.Num());
+    }
+}
+
+const FVortexOutputSnapshot& FVortexOutputSnapshotChannel::Read(bool& bNew)
+{
+    bNew = (SharedIndex.Load() & DirtyFlag) != 0;
+    if (bNew)
+    {
+        ReadIndex = SharedIndex.Exchange(ReadIndex) & IndexMask;
+    }
+
+    return Buffers[ReadIndex];
+}
+
+void FVortexOutputSnapshotChannel::Publish()
+{
+    SCOPE_CYCLE_COUNTER(STAT_PublishOutputSnapshot);
+    if (!bBound)
+    {
+        return;
+    }
+
+    FVortexOutputSnapshot& Snapshot = Buffers[WriteIndex];
+    Snapshot.Frame = VortexGetFrame();
+    Snapshot.SimulationTime = VortexGetSimulationTime();
+
+    int32 Indices[static_cast<int32>(EVortexVHLDataType::Transform) + 1] = {};
+    for (const FVortexFieldHandle& Handle : Outputs)
+    {
+        const int32 Index = Indices[static_cast<int32>(Handle.DataType)]++;
+        if (!Handle.ReadOutput(Snapshot.Outputs, Index))
+        {
+            UE_LOG(LogVortex, Error, TEXT("FVortexOutputSnapshotChannel::Publish(): Interface \"%s\" and field \"%s\". The output could not be read."), UTF8_TO_TCHAR(Handle.GetInterfaceName()), UTF8_TO_TCHAR(Handle.GetFieldName()));
+        }
+    }
+
+    // Read all the nodes, then convert them in one pass
+    const int32 NodeCount = GraphicNodes.Num();
+    TArray<double, TInlineAllocator<64 * 10>> Poses;
+    Poses.SetNumZeroed(NodeCount * 10);
+    double* Translations = Poses.GetData();
+    double* Scales = Translations + NodeCount * 3;
+    double* Rotations = Scales + NodeCount * 3;
+    for (int i = 0; i < NodeCount; ++i)
+    {
+        VortexGetParentTransform(GraphicNodes[i], Translations + i * 3, Scales + i * 3, Rotations + i * 4);
+    }
+    VortexIntegrationUtilities::ConvertTransforms(Translations, Scales, Rotations, NodeCount, Snapshot.GraphicNodeTransforms.GetData());
+
+    WriteIndex = SharedIndex.Exchange(WriteIndex | DirtyFlag) & IndexMask;
+}
@@ -1,4 +1,5 @@
 #include "VortexRuntime.h"
+#include "VortexSimulationThread.h"
 #include "VortexTerrain.h"
 
 #include "VortexApplicationBlueprintLib.h"
@@ -10,11 +11,13 @@
 #include "Runtime/Core/Public/Misc/Paths.h"
 #include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
 #include "Misc/MessageDialog.h"
+#include "Async/ParallelFor.h"
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "VortexIntegration/Version.h"
 #include "VortexIntegration/GraphicsIntegration.h"
 #include "MechanismComponent.h"
+#include "VortexMechanismInstancer.h"
 #include "VortexLidarActor.h"
 #include "VortexLidarActorComponent.h"
 #include "VortexDepthCameraActor.h"
@@ -23,9 +26,12 @@
 #include "VortexColorCameraActorComponent.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
 
 #if WITH_EDITOR
 #include "Editor.h" // for FEditorDelegates
+#include "EditorViewportClient.h"
 #endif
 
 #include <string>
@@ -35,6 +41,20 @@
 DEFINE_LOG_CATEGORY(LogVortex);
 
 DECLARE_CYCLE_STAT(TEXT("Tick"), STAT_ModuleTick, STATGROUP_VortexRuntimeModule);
+DECLARE_CYCLE_STAT(TEXT("TickMechanismComponents"), STAT_TickMechanismComponents, STATGROUP_VortexRuntimeModule);
+DECLARE_CYCLE_STAT(TEXT("UpdateMechanismSignificance"), STAT_UpdateMechanismSignificance, STATGROUP_VortexRuntimeModule);
+DECLARE_CYCLE_STAT(TEXT("ConvertSceneTransforms"), STAT_ConvertSceneTransforms, STATGROUP_VortexRuntimeModule);
+DECLARE_CYCLE_STAT(TEXT("LoadPendingMechanisms"), STAT_LoadPendingMechanisms, STATGROUP_VortexRuntimeModule);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PendingMechanismLoads"), STAT_PendingMechanismLoads, STATGROUP_VortexRuntimeModule);
+DECLARE_CYCLE_STAT(TEXT("EvictPooledMechanisms"), STAT_EvictPooledMechanisms, STATGROUP_VortexRuntimeModule);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PooledMechanisms"), STAT_PooledMechanisms, STATGROUP_VortexRuntimeModule);
+DECLARE_CYCLE_STAT(TEXT("LoadDeferredEditorMechanisms"), STAT_LoadDeferredEditorMechanisms, STATGROUP_VortexRuntimeModule);
+DECLARE_DWORD_COUNTER_STAT(TEXT("DeferredEditorMechanisms"), STAT_DeferredEditorMechanisms, STATGROUP_VortexRuntimeModule);
+DECLARE_DWORD_COUNTER_STAT(TEXT("StepsPerFrame"), STAT_StepsPerFrame, STATGROUP_VortexRuntimeModule);
+DECLARE_DWORD_COUNTER_STAT(TEXT("StepDebt"), STAT_StepDebt, STATGROUP_VortexRuntimeModule);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("AverageStepCost (ms)"), STAT_AverageStepCost, STATGROUP_VortexRuntimeModule);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("RealTimeFactor"), STAT_RealTimeFactor, STATGROUP_VortexRuntimeModule);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("StepToDisplayLatency (ms)"), STAT_StepToDisplayLatency, STATGROUP_VortexRuntimeModule);
 
 namespace
 {
@@ -86,10 +106,35 @@ namespace
         }
     }
 
+    void VortexGraphicNodeCallback(GraphicNotificationType type, GraphicNodeInfo* nodeInfo)
+    {
+        FVortexRuntimeModule::Get().OnGraphicNodeNotification(type, *nodeInfo);
+    }
+
+    void VortexVHLCallback(GraphicNotificationType type, VHLInfo* vhlInfo)
+    {
+        FVortexRuntimeModule::Get().OnVHLNotification(type, *vhlInfo);
+    }
+
     const TCHAR* PromptForDebuggerEnvVar = TEXT("DEBUG_VORTEX_UNREAL_PLUGIN");
 
-    // What do we consider as being an outstanding period (delta time)? Here, we arbitrary define a factor of the period that we consider as invalid.
-    const double OutstandingPeriodFactor = 4.0;
+    // Weight of the last measured step in the rolling average step cost
+    const double StepCostSmoothingFactor = 0.1;
+
+    // Maximum number of steps run in a frame while their cost is unknown or not budgeted, any time owed beyond that is discarded
+    const int32 MaxUnbudgetedStepCount = 4;
+
+    // Period, in seconds, of the evaluation of the significance of the mechanisms
+    const double SignificanceUpdatePeriod = 0.25;
+
+    // Period, in seconds, of the evaluation of the selection and distance of the deferred editor components
+    const double DeferredEditorMechanismsUpdatePeriod = 0.25;
+
+    // A mechanism not rendered for this long, in seconds, is considered off-screen or occluded
+    const float SignificanceRenderTimeout = 0.5f;
+
+    // Weight of the last frame in the rolling real-time factor
+    const double RealTimeFactorSmoothingFactor = 0.1;
 
     bool SortStrings(const FString& first, const FString& second)
     {
@@ -213,241 +258,1204 @@ namespace
         return returnedDir;
     }
 
-    // Unreal holds multiple components at the same time to represent the same piece of data in different contexts
-    // Dragging an object in the 3D view, editing Blueprints, each have their own component instance
-    // We want them all to share the same Vortex Mechanism reference
-    // This function produces the proper hash for this purpose
-    FString MakeKey(UMechanismComponent* Component)
+    void UnloadAsset(VortexObjectHandle VortexObject)
+    {
+        if (!FVortexRuntimeModule::IsIntegrationLoaded())
+        {
+            return;
+        }
+
+        if (VortexObject != nullptr)
+        {
+            if (VortexUnloadMechanism(VortexObject))
+            {
+                UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::UnloadAsset(): Successfully unloaded Vortex object."));
+            }
+            else
+            {
+                UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::UnloadAsset(): Failed to unload Vortex object."));
+            }
+        }
+    }
+
+    void LoadAsset(VortexObjectHandle& VortexObject, UMechanismComponent* Component)
+    {
+        if (!FVortexRuntimeModule::IsIntegrationLoaded())
+            return;
+
+        if (Component->VortexMechanism == nullptr)
+            return;
+
+        FString absoluteFilepath = FPaths::Combine(FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()), Component->VortexMechanism->MechanismFilepath.FilePath);
+
+        double translation[3];
+        double rotation[4];
+
+        AActor* parentActor = Component->GetOwner();
+        VortexIntegrationUtilities::ConvertTransform(parentActor->GetTransform(), translation, rotation);
+        VortexObject = VortexLoadMechanism(TCHAR_TO_UTF8(*absoluteFilepath), translation, rotation);
+        if (VortexObject == nullptr)
+        {
+            UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::LoadAsset(): Unable to load Vortex object from file <%s>."), *absoluteFilepath);
+        }
+        else
+        {
+            UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::LoadAsset(): Successfully loaded Vortex object from file <%s>."), *absoluteFilepath);
+        }
+    }
+    
+    // The sensor actors of a pooled mechanism stay in their world, hidden and idle, until the mechanism is reused or unloaded
+    void SetSensorActorActive(AActor* Actor, bool bActive)
+    {
+        Actor->SetActorHiddenInGame(!bActive);
+        Actor->SetActorTickEnabled(bActive);
+        if (USceneComponent* Root = Actor->GetRootComponent())
+        {
+            Root->SetComponentTickEnabled(bActive);
+        }
+    }
+
+    // Releases the sensor actors of a world being cleaned up, the hidden actors of pooled mechanisms included
+    void ReleaseSensorActors(TMap<uint64_t, AActor*>& Sensors, const UWorld* World)
+    {
+        for (auto& pair : Sensors)
+        {
+            if (pair.Value != nullptr && pair.Value->GetWorld() == World)
+            {
+                pair.Value->Destroy();
+                pair.Value = nullptr;
+            }
+        }
+    }
+
+    void LoadAllEditorMechanisms()
+    {
+        FVortexRuntimeModule::Get().LoadAllEditorMechanisms();
+    }
+
+    FAutoConsoleCommand LoadAllEditorMechanismsCommand(
+        TEXT("Vortex.LoadAllEditorMechanisms"),
+        TEXT("Loads the mechanisms of all the editor components deferred by lazy editor mechanism loading, over the next frames."),
+        FConsoleCommandDelegate::CreateStatic(&LoadAllEditorMechanisms));
+
+    void TerrainProviderQuery(VortexTerrainProvider Terrain, const VortexTerrainProviderRequest* request, VortexTerrainProviderResponse* response)
+    {
+        reinterpret_cast<FVortexTerrain*>(Terrain)->Query(request, response);
+    }
+
+    void TerrainProviderPostQuery(VortexTerrainProvider Terrain)
+    {
+        reinterpret_cast<FVortexTerrain*>(Terrain)->PostQuery();
+    }
+
+    void TerrainProviderOnDestroy(VortexTerrainProvider Terrain)
+    {
+        reinterpret_cast<FVortexTerrain*>(Terrain)->OnDestroy();
+    }
+}
+
+FVortexRuntimeModule::FVortexRuntimeModule()
+    : CurrentWorldContext(nullptr)
+    , VortexIntegrationHandle(nullptr)
+    , AccumulatedTime(0)
+    , VortexPeriod(0.0)
+    , SimulationThread(nullptr)
+    , bInterpolateTransforms(false)
+    , StepsSinceCapture(0)
+    , CapturedStepGap(1)
+    , StepBudget(0.0)
+    , CatchUpBehavior(EVortexCatchUpBehavior::SlowMotion)
+    , MaxStepDebt(4)
+    , AverageStepCost(0.0)
+    , bStepCostSimulating(false)
+    , TargetSpeedMultiplier(1.0f)
+    , BatchStepsPerTick(0)
+    , BatchVisualSyncInterval(1)
+    , StepsSinceVisualSync(0)
+    , bSyncVisuals(true)
+    , RealTimeFactor(0.0)
+    , PipelinedStepsDeltaTime(0.0f)
+    , bVHLOutputChangesPending(false)
+    , bGraphicNodeNotifications(false)
+    , bSignificanceUpdates(false)
+    , SignificanceNearDistance(0.0f)
+    , SignificanceFarDistance(0.0f)
+    , SignificanceMinScreenSize(0.0f)
+    , SignificanceMidRangeInterval(1)
+    , SignificanceFarInterval(1)
+    , SignificanceHiddenInterval(1)
+    , LastSignificanceUpdateTime(0.0)
+    , bCentralizedTick(false)
+    , bTickGroupIntegration(false)
+    , LastStepEndTime(0.0)
+    , LastDisplayedStepEndTime(0.0)
+    , bAsynchronousMechanismLoading(false)
+    , MechanismLoadBudget(0.0)
+    , bStartSimulationWhenLoaded(false)
+    , bLazyEditorMechanismLoading(false)
+    , EditorMechanismLoadDistanceSquared(0.0)
+    , LastDeferredEditorMechanismsUpdateTime(0.0)
+    , bLoadAllEditorMechanisms(false)
+    , bMechanismActorListDirty(false)
+    , bWarmPlayInEditorRestart(false)
+    , bEndingPlayInEditor(false)
+    , MechanismPoolLifetime(0.0)
+    , MechanismPoolCapacity(0)
+    , MechanismUnloadBudget(0.0)
+    , Terrain(nullptr)
+{
+}
+
+void FVortexRuntimeModule::RegisterComponent(UMechanismComponent* Component)
+{
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+    {
+        return;
+    }
+
+    WaitForSimulationStep();
+
+    // We want to enforce the fact that a mechanism is expected to be loaded in Editing mode
+    if (VortexGetApplicationMode() != kVortexModeEditing)
+    {
+        UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::RegisterComponent(): The Vortex application MUST be in Editing mode to load Vortex object from file <%s>."), *Component->VortexMechanism->MechanismFilepath.FilePath);
+        return;
+    }
+
+    if (Component->VortexObject)
+    {
+        UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::RegisterComponent(): The VortexObject should be NULL <%s>."), *Component->VortexMechanism->MechanismFilepath.FilePath);
+        return;
+    }
+
+    Component->LoadedMechanismKey = FMechanismKey(Component);
+    if (!Component->LoadedMechanismKey.IsValid())
+    {
+        UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::RegisterComponent(): Invalid component."));
+    }
+
+    // We are willing to share the same Vortex Mechanism reference among multiple instances of components sharing an identical
+    // key. See FMechanismKey.
+    FMechanismRegistryEntry* Entry = Mechanisms.Find(Component->LoadedMechanismKey);
+    if (Entry == nullptr)
+    {
+        // Components get created and destroyed quite often and sometimes out of order (undo-redo, dragging, etc)
+        // We don't want to immediately unload a Vortex Mechanism if it will be loaded again in the same frame
+        // We keep a short lived pool of recently unloaded mechanisms available for reuse by components sharing an identical key
+        VortexObjectHandle VortexObject = nullptr;
+        bool bLoadPending = false;
+        const FMechanismKey& Key = Component->LoadedMechanismKey;
+        const int32 PoolIndex = MechanismPool.FindLastByPredicate([&Key](const FPooledMechanism& Pooled) { return Pooled.Key == Key; });
+        if (PoolIndex != INDEX_NONE)
+        {
+            VortexObject = MechanismPool[PoolIndex].VortexObject;
+            MechanismPool.RemoveAt(PoolIndex);
+
+            // The actor of a streamed level starts over where the level places it, like a freshly loaded mechanism
+            if (Component->HasBegunPlay())
+            {
+                double translation[3];
+                double rotation[4];
+                VortexIntegrationUtilities::ConvertTransform(Component->GetOwner()->GetTransform(), translation, rotation);
+                VortexSetWorldTransform(VortexObject, translation, rotation);
+            }
+        }
+        else if (bAsynchronousMechanismLoading && Component->HasBegunPlay())
+        {
+            // Loading can take hundreds of milliseconds, spread the loads of the components beginning play over the next frames
+            PendingMechanismLoads.Add(Component->LoadedMechanismKey);
+            bLoadPending = true;
+        }
+        else
+        {
+            RegisteringMechanism = Component->LoadedMechanismKey;
+            LoadAsset(VortexObject, Component);
+            RegisteringMechanism = FMechanismKey();
+        }
+
+        Entry = &Mechanisms.Add(Component->LoadedMechanismKey);
+        Entry->VortexObject = VortexObject;
+        Entry->bLoadPending = bLoadPending;
+    }
+
+    // Track the new mechanism component reference
+    Component->VortexObject = Entry->VortexObject;
+    Component->bMechanismLoadPending = Entry->bLoadPending;
+    Entry->Components.Add(Component);
+    ++MechanismActors.FindOrAdd(Component->GetOwner());
+    bMechanismActorListDirty = true;
+}
+
+void FVortexRuntimeModule::UnregisterComponent(UMechanismComponent* Component, bool bImmediately)
+{
+    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+    {
+        return;
+    }
+
+    WaitForSimulationStep();
+
+    // Deferred editor components never registered anything, see DeferEditorComponent()
+    if (DeferredEditorComponents.RemoveSingleSwap(Component) > 0)
+    {
+        return;
+    }
+
+    // Components whose registration failed hold no reference to the actor or the mechanism
+    FMechanismRegistryEntry* Entry = Mechanisms.Find(Component->LoadedMechanismKey);
+    const bool bRegistered = Entry != nullptr && Entry->Components.Contains(Component);
+    if (bRegistered)
+    {
+        if (int32* ActorComponentCount = MechanismActors.Find(Component->GetOwner()))
+        {
+            if (--(*ActorComponentCount) <= 0)
+            {
+                MechanismActors.Remove(Component->GetOwner());
+                bMechanismActorListDirty = true;
+            }
+        }
+    }
+
+    bool bLastReference = false;
+    bool bLoadPending = false;
+    if (bRegistered)
+    {
+        Entry->Components.RemoveSingleSwap(Component);
+        bLastReference = Entry->Components.Num() == 0;
+        bLoadPending = Entry->bLoadPending;
+        if (bLastReference)
+        {
+            Mechanisms.Remove(Component->LoadedMechanismKey);
+        }
+    }
+
+    if (bLastReference && bLoadPending)
+    {
+        // Nothing was loaded yet
+        PendingMechanismLoads.RemoveSingle(Component->LoadedMechanismKey);
+    }
+    // We don't want to unload a Vortex Mechanism if another component is referring to it.
+    else if (bLastReference)
+    {
+        if (bImmediately)
+        {
+            RegisteringMechanism = Component->LoadedMechanismKey;
+            // On EndPlay we want to unload a Vortex Mechanism immediately to guarantee no state leaks from play to play.
+            UnloadAsset(Component->VortexObject);
+            RegisteringMechanism = FMechanismKey();
+        }
+        else if (Component->VortexObject != nullptr)
+        {
+            // We don't want to immediately unload a Vortex Mechanism if it will be loaded again in the same frame,
+            // or in a few seconds when its streamed level comes back. See EvictPooledMechanisms().
+            // The mechanisms of the world torn down at the end of play in editor are kept for the next session
+            const UWorld* World = Component->GetWorld();
+            const bool bRetainedForRestart = bEndingPlayInEditor && World != nullptr && World->WorldType == EWorldType::PIE;
+            MechanismPool.Add({ Component->LoadedMechanismKey, Component->VortexObject, FPlatformTime::Seconds(), bRetainedForRestart });
+        }
+    }
+
+    UnbindGraphicNodeTwins(Component);
+    CentrallyTickedComponents.RemoveSingleSwap(Component);
+    Component->onComponentUnregistered();
+
+    Component->LoadedMechanismKey = FMechanismKey();
+    Component->VortexObject = nullptr;
+}
+
+void FVortexRuntimeModule::UnregisterAllComponents(const FMechanismKey& LoadedMechanismKey, bool bImmediately)
+{
+    const FMechanismRegistryEntry* Entry = Mechanisms.Find(LoadedMechanismKey);
+    if (Entry == nullptr)
+    {
+        return;
+    }
+
+    // On EndPlay we want to unload a Vortex Mechanism immediately to guarantee no state leaks from play to play,
+    // except for the components of a streamed level being removed, which are likely to come back.
+    // Unregistering a sibling removes it from the entry
+    const TArray<UMechanismComponent*> siblings = Entry->Components;
+    for (auto& sibling : siblings)
+    {
+        UnregisterComponent(sibling, bImmediately);
+    }
+}
+
+void FVortexRuntimeModule::EvictPooledMechanisms()
+{
+    SET_DWORD_STAT(STAT_PooledMechanisms, MechanismPool.Num());
+    int32 PooledCount = 0;
+    for (const FPooledMechanism& Pooled : MechanismPool)
+    {
+        PooledCount += Pooled.bRetainedForRestart ? 0 : 1;
+    }
+
+    if (PooledCount == 0)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_EvictPooledMechanisms);
+    const double StartTime = FPlatformTime::Seconds();
+    int32 EvictedCount = 0;
+    for (int32 Index = 0; Index < MechanismPool.Num();)
+    {
+        const FPooledMechanism& Pooled = MechanismPool[Index];
+        if (Pooled.bRetainedForRestart)
+        {
+            ++Index;
+            continue;
+        }
+
+        const bool bExpired = StartTime - Pooled.ReleaseTime >= MechanismPoolLifetime;
+        const bool bOverCapacity = PooledCount > MechanismPoolCapacity;
+        if (!bExpired && !bOverCapacity)
+        {
+            break;
+        }
+
+        if (EvictedCount > 0 && FPlatformTime::Seconds() - StartTime >= MechanismUnloadBudget)
+        {
+            break;
+        }
+
+        RegisteringMechanism = Pooled.Key;
+        UnloadAsset(Pooled.VortexObject);
+        RegisteringMechanism = FMechanismKey();
+        MechanismPool.RemoveAt(Index);
+        --PooledCount;
+        ++EvictedCount;
+    }
+}
+
+void FVortexRuntimeModule::LoadPendingMechanisms()
+{
+    SET_DWORD_STAT(STAT_PendingMechanismLoads, PendingMechanismLoads.Num());
+    if (PendingMechanismLoads.Num() == 0)
+    {
+        return;
+    }
+
+    // Mechanisms are only loaded in Editing mode, StartSimulation() waits for the pending ones
+    if (VortexGetApplicationMode() != kVortexModeEditing)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_LoadPendingMechanisms);
+    const double StartTime = FPlatformTime::Seconds();
+    do
+    {
+        const FMechanismKey Key = PendingMechanismLoads[0];
+        PendingMechanismLoads.RemoveAt(0);
+
+        FMechanismRegistryEntry* Entry = Mechanisms.Find(Key);
+        if (Entry == nullptr || !Entry->bLoadPending || Entry->Components.Num() == 0)
+        {
+            continue;
+        }
+
+        VortexObjectHandle VortexObject = nullptr;
+        RegisteringMechanism = Key;
+        LoadAsset(VortexObject, Entry->Components[0]);
+        RegisteringMechanism = FMechanismKey();
+
+        Entry->VortexObject = VortexObject;
+        Entry->bLoadPending = false;
+        for (UMechanismComponent* Component : Entry->Components)
+        {
+            Component->VortexObject = VortexObject;
+        }
+
+        // Completion delegates can register or unregister components
+        const TArray<UMechanismComponent*> Components = Entry->Components;
+        for (UMechanismComponent* Component : Components)
+        {
+            if (IsValid(Component) && Component->bMechanismLoadPending)
+            {
+                Component->OnMechanismLoadCompleted();
+            }
+        }
+    }
+    while (PendingMechanismLoads.Num() > 0 && FPlatformTime::Seconds() - StartTime < MechanismLoadBudget);
+
+    if (PendingMechanismLoads.Num() == 0 && bStartSimulationWhenLoaded)
+    {
+        bStartSimulationWhenLoaded = false;
+        UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::LoadPendingMechanisms(): The pending mechanisms are loaded, starting simulation."));
+        VortexSetApplicationMode(kVortexModeSimulating, true);
+    }
+}
+
+bool FVortexRuntimeModule::DeferEditorComponent(UMechanismComponent* Component)
+{
+    if (!bLazyEditorMechanismLoading || !FVortexRuntimeModule::IsIntegrationLoaded())
+    {
+        return false;
+    }
+
+    // Moving, editing or undoing an actor reregisters its components, which reuse their pooled mechanism right away
+    const FMechanismKey Key(Component);
+    if (Mechanisms.Contains(Key) || MechanismPool.ContainsByPredicate([&Key](const FPooledMechanism& Pooled) { return Pooled.Key == Key; }))
+    {
+        return false;
+    }
+
+#if WITH_EDITOR
+    if (Component->GetOwner() != nullptr && Component->GetOwner()->IsSelected())
+    {
+        return false;
+    }
+#endif
+
+    DeferredEditorComponents.AddUnique(Component);
+    return true;
+}
+
+void FVortexRuntimeModule::LoadAllEditorMechanisms()
+{
+    if (DeferredEditorComponents.Num() == 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::LoadAllEditorMechanisms(): Loading %d deferred editor mechanisms."), DeferredEditorComponents.Num());
+    bLoadAllEditorMechanisms = true;
+}
+
+void FVortexRuntimeModule::LoadDeferredEditorMechanisms()
+{
+    SET_DWORD_STAT(STAT_DeferredEditorMechanisms, DeferredEditorComponents.Num());
+    if (DeferredEditorComponents.Num() == 0)
+    {
+        bLoadAllEditorMechanisms = false;
+        return;
+    }
+
+#if WITH_EDITOR
+    // The selection and the viewports change at the pace of the user
+    if (!bLoadAllEditorMechanisms && FPlatformTime::Seconds() - LastDeferredEditorMechanismsUpdateTime < DeferredEditorMechanismsUpdatePeriod)
+    {
+        return;
+    }
+    LastDeferredEditorMechanismsUpdateTime = FPlatformTime::Seconds();
+
+    // Mechanisms are only loaded in Editing mode
+    if (GEditor == nullptr || VortexGetApplicationMode() != kVortexModeEditing)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_LoadDeferredEditorMechanisms);
+
+    TArray<FVector> ViewLocations;
+    if (EditorMechanismLoadDistanceSquared > 0.0)
+    {
+        for (FEditorViewportClient* ViewportClient : GEditor->GetAllViewportClients())
+        {
+            if (ViewportClient != nullptr && ViewportClient->IsPerspective() && ViewportClient->GetWorld() != nullptr && ViewportClient->GetWorld()->WorldType == EWorldType::Editor)
+            {
+                ViewLocations.Add(ViewportClient->GetViewLocation());
+            }
+        }
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    for (int32 Index = DeferredEditorComponents.Num() - 1; Index >= 0; --Index)
+    {
+        UMechanismComponent* Component = DeferredEditorComponents[Index];
+        if (!IsValid(Component) || Component->GetOwner() == nullptr)
+        {
+            DeferredEditorComponents.RemoveAtSwap(Index);
+            continue;
+        }
+
+        const AActor* Actor = Component->GetOwner();
+        bool bShouldLoad = bLoadAllEditorMechanisms || Actor->IsSelected();
+        for (int32 ViewIndex = 0; !bShouldLoad && ViewIndex < ViewLocations.Num(); ++ViewIndex)
+        {
+            bShouldLoad = FVector::DistSquared(ViewLocations[ViewIndex], Actor->GetActorLocation()) <= EditorMechanismLoadDistanceSquared;
+        }
+
+        if (!bShouldLoad)
+        {
+            continue;
+        }
+
+        DeferredEditorComponents.RemoveAtSwap(Index);
+        Component->LoadEditorMechanism();
+
+        if (FPlatformTime::Seconds() - StartTime >= MechanismLoadBudget)
+        {
+            // Carry on next frame with the remaining components
+            LastDeferredEditorMechanismsUpdateTime = 0.0;
+            break;
+        }
+    }
+
+    if (DeferredEditorComponents.Num() == 0)
+    {
+        bLoadAllEditorMechanisms = false;
+    }
+#endif
+}
+
+void FVortexRuntimeModule::WaitForSimulationStep()
+{
+    if (SimulationThread == nullptr || !SimulationThread->IsBusy())
+    {
+        return;
+    }
+
+    check(IsInGameThread());
+    SimulationThread->Wait();
+    RecordStepCost(SimulationThread->GetLastStepsDuration(), SimulationThread->GetLastStepCount());
+    RecordRealTimeFactor(SimulationThread->GetLastStepCount(), PipelinedStepsDeltaTime);
+    LastStepEndTime = SimulationThread->GetLastStepsEndTime();
+
+    // Outputs of the pipelined steps are captured once per join, on the game thread
+    StepsSinceCapture += SimulationThread->GetLastStepCount();
+    CaptureStepOutputs();
+    GatherVHLBatchOutputs();
+    bVHLOutputChangesPending = true;
+
+    // Apply what was received while the step was in flight, so it is seen by the next step
+    TArray<TFunction<void()>> Commands = MoveTemp(StepBoundaryCommands);
+    StepBoundaryCommands.Reset();
+    for (auto& Command : Commands)
+    {
+        Command();
+    }
+}
+
+bool FVortexRuntimeModule::IsSimulationStepInFlight() const
+{
+    return SimulationThread != nullptr && SimulationThread->IsBusy();
+}
+
+bool FVortexRuntimeModule::DeferUntilStepBoundary(TFunction<void()>&& Command)
+{
+    if (!IsSimulationStepInFlight())
+    {
+        return false;
+    }
+
+    StepBoundaryCommands.Add(MoveTemp(Command));
+    return true;
+}
+
+bool FVortexRuntimeModule::CanStepOnSimulationThread() const
+{
+    if (SimulationThread == nullptr || Lidars.Num() != 0 || DepthCameras.Num() != 0 || ColorCameras.Num() != 0)
+    {
+        return false;
+    }
+
+    // The terrain provider queries the overlaps of the world and the mechanism actors while the game thread ticks them
+    if (Terrain != nullptr)
+    {
+        return false;
+    }
+
+    // Queued inputs are applied between steps, from the game thread
+    for (auto& pair : Mechanisms)
+    {
+        for (UMechanismComponent* Component : pair.Value.Components)
+        {
+            if (Component->HasQueuedVHLInputs())
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void FVortexRuntimeModule::FlushVHLBatchInputs()
+{
+    for (auto& pair : Mechanisms)
+    {
+        for (UMechanismComponent* Component : pair.Value.Components)
+        {
+            Component->FlushVHLBatchInputs();
+        }
+    }
+}
+
+void FVortexRuntimeModule::GatherVHLBatchOutputs()
+{
+    for (auto& pair : Mechanisms)
+    {
+        for (UMechanismComponent* Component : pair.Value.Components)
+        {
+            Component->GatherVHLBatchOutputs();
+        }
+    }
+}
+
+void FVortexRuntimeModule::DispatchVHLOutputChanges()
+{
+    bVHLOutputChangesPending = false;
+
+    // Delegates can register or unregister components
+    TArray<UMechanismComponent*> Components;
+    for (auto& pair : Mechanisms)
+    {
+        Components.Append(pair.Value.Components);
+    }
+    for (UMechanismComponent* Component : Components)
+    {
+        if (IsValid(Component))
+        {
+            Component->DispatchVHLOutputChanges();
+        }
+    }
+}
+
+void FVortexRuntimeModule::OnVHLNotification(GraphicNotificationType Type, const VHLInfo&)
+{
+    // Vortex does not say which field changed, every subscription is compared anyway.
+    // An update only makes sure the outputs are compared at the next world tick, even if no step runs by then.
+    if (Type == GraphicNotificationType_Update)
+    {
+        bVHLOutputChangesPending = true;
+    }
+}
+
+void FVortexRuntimeModule::OnGraphicNodeNotification(GraphicNotificationType Type, const GraphicNodeInfo& nodeInfo)
+{
+    if (Type == GraphicNotificationType_Update)
+    {
+        if (!IsPushingGraphicNodes() || !GraphicNodeTwins.Contains(nodeInfo.id))
+        {
+            return;
+        }
+
+        // Only the last update of a node matters when several steps run in a frame.
+        // A scale factor has no unit, and it is the local scale of the node, see UMechanismComponent::MoveNotifiedGraphicNodeTwin
+        FVortexGraphicNodeUpdate& Update = PendingGraphicNodeUpdates.FindOrAdd(nodeInfo.id);
+        Update.Transform = FTransform(VortexIntegrationUtilities::ConvertRotation(nodeInfo.rotation), VortexIntegrationUtilities::ConvertTranslation(nodeInfo.position), FVector(nodeInfo.localScale[0], nodeInfo.localScale[1], nodeInfo.localScale[2]));
+        Update.bVisible = nodeInfo.visible;
+    }
+    else if (RegisteringMechanism.IsValid() && nodeInfo.name != nullptr)
+    {
+        // Nodes are added and removed while their mechanism is loaded or unloaded
+        TMap<FString, uint64>& Nodes = MechanismGraphicNodes.FindOrAdd(RegisteringMechanism);
+        const FString NodeName = UTF8_TO_TCHAR(nodeInfo.name);
+        if (Type == GraphicNotificationType_Add)
+        {
+            uint64* ExistingId = Nodes.Find(NodeName);
+            Nodes.Add(NodeName, ExistingId != nullptr ? 0 : nodeInfo.id);
+        }
+        else
+        {
+            Nodes.Remove(NodeName);
+            GraphicNodeTwins.Remove(nodeInfo.id);
+            PendingGraphicNodeUpdates.Remove(nodeInfo.id);
+            if (Nodes.Num() == 0)
+            {
+                MechanismGraphicNodes.Remove(RegisteringMechanism);
+            }
+        }
+    }
+}
+
+void FVortexRuntimeModule::BindGraphicNodeTwins(UMechanismComponent* Component, const TArray<FString>& TwinNodeNames, TArray<bool>& Pushed)
+{
+    Pushed.Init(false, TwinNodeNames.Num());
+    const TMap<FString, uint64>* Nodes = MechanismGraphicNodes.Find(Component->LoadedMechanismKey);
+    if (!bGraphicNodeNotifications || Nodes == nullptr)
+    {
+        return;
+    }
+
+    for (int32 i = 0; i < TwinNodeNames.Num(); ++i)
+    {
+        const uint64* NodeId = Nodes->Find(TwinNodeNames[i]);
+        if (NodeId != nullptr && *NodeId != 0)
+        {
+            GraphicNodeTwins.Add(*NodeId, TPair<TWeakObjectPtr<UMechanismComponent>, int32>(Component, i));
+            Pushed[i] = true;
+        }
+    }
+}
+
+void FVortexRuntimeModule::UnbindGraphicNodeTwins(UMechanismComponent* Component)
+{
+    for (auto It = GraphicNodeTwins.CreateIterator(); It; ++It)
+    {
+        if (It.Value().Key == Component || !It.Value().Key.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FVortexRuntimeModule::ApplyGraphicNodeUpdates()
+{
+    // In batch mode, the updates accumulate until the next visual sync
+    if (PendingGraphicNodeUpdates.Num() == 0 || !bSyncVisuals)
+    {
+        return;
+    }
+
+    TArray<TPair<TWeakObjectPtr<UMechanismComponent>, int32>> Twins;
+    for (const auto& pair : PendingGraphicNodeUpdates)
+    {
+        Twins.Reset();
+        GraphicNodeTwins.MultiFind(pair.Key, Twins);
+        for (const auto& Twin : Twins)
+        {
+            if (UMechanismComponent* Component = Twin.Key.Get())
+            {
+                Component->ApplyGraphicNodeUpdate(Twin.Value, pair.Value);
+            }
+        }
+    }
+
+    PendingGraphicNodeUpdates.Reset();
+}
+
+TArray<FVortexInputCommandQueuePtr> FVortexRuntimeModule::GetInputCommandQueues() const
+{
+    TArray<FVortexInputCommandQueuePtr> Queues;
+    for (auto& pair : Mechanisms)
+    {
+        for (UMechanismComponent* Component : pair.Value.Components)
+        {
+            if (Component->InputCommandQueue.IsValid())
+            {
+                Queues.Add(Component->InputCommandQueue);
+            }
+        }
+    }
+
+    return Queues;
+}
+
+TArray<FVortexOutputSnapshotChannelPtr> FVortexRuntimeModule::GetOutputSnapshotChannels()
+{
+    TArray<FVortexOutputSnapshotChannelPtr> Channels;
+    for (auto& pair : Mechanisms)
+    {
+        for (UMechanismComponent* Component : pair.Value.Components)
+        {
+            // The component holds one reference, a channel with no other reference was released by its subscriber
+            Component->OutputSnapshotChannels.RemoveAllSwap([](const FVortexOutputSnapshotChannelPtr& Channel)
+            {
+                return Channel.GetSharedReferenceCount() == 1;
+            });
+            Channels.Append(Component->OutputSnapshotChannels);
+        }
+    }
+
+    return Channels;
+}
+
+void FVortexRuntimeModule::ApplyQueuedVHLInputs()
+{
+    const double SimulationTime = VortexGetSimulationTime();
+    for (auto& pair : Mechanisms)
+    {
+        for (UMechanismComponent* Component : pair.Value.Components)
+        {
+            Component->ApplyQueuedVHLInputs(SimulationTime);
+        }
+    }
+}
+
+void FVortexRuntimeModule::OnWorldTickStart(UWorld*, ELevelTick, float)
+{
+    WaitForSimulationStep();
+
+    ApplyGraphicNodeUpdates();
+
+    // Delegates are not called from the join itself, which can happen in the middle of any Vortex call
+    if (bVHLOutputChangesPending)
+    {
+        DispatchVHLOutputChanges();
+    }
+}
+
+void FVortexRuntimeModule::OnWorldPostActorTick(UWorld* World, ELevelTick, float)
+{
+    // Already synchronized in TG_PostPhysics
+    if (!IsIntegratedInWorldTick(World))
+    {
+        SyncMechanismComponents(World);
+    }
+
+    // The scene of the simulated world is final for this frame
+    if (World == GetCurrentWorld())
+    {
+        RecordStepToDisplayLatency();
+    }
+}
+
+void FVortexRuntimeModule::SyncMechanismComponents(UWorld* World)
+{
+    SCOPE_CYCLE_COUNTER(STAT_TickMechanismComponents);
+
+    // In batch mode, visuals are only synchronized once in a while
+    if (CentrallyTickedComponents.Num() == 0 || !bSyncVisuals)
+    {
+        return;
+    }
+
+    WaitForSimulationStep();
+
+#if WITH_EDITOR
+    if (VortexGetApplicationMode() != kVortexModeSimulating && GEngine)
+    {
+        //221518200524 is vortex as numbers. The first parameter of UEngine::AddOnScreenDebugMessage is a unique number used to identify the message in the screen.
+        //It prevents the same message from being printed multiple times.
+        GEngine->AddOnScreenDebugMessage(uint64(221518200524), 0.5, FColor::Red, FString("Vortex simulation is not started and a vortex mechanism is present in the level. Call 'Start Simulation' in a level blueprint to start the Vortex simulation."));
+    }
+#endif
+
+    // Vortex is only read from the game thread, the conversions are spread over the task graph, and the scene is only touched from the game thread
+    TArray<UMechanismComponent*> Components;
+    Components.Reserve(CentrallyTickedComponents.Num());
+    for (UMechanismComponent* Component : CentrallyTickedComponents)
+    {
+        if (Component->VortexObject != nullptr && Component->GetWorld() == World && Component->ConsumeVisualUpdate())
+        {
+            Component->GatherSceneTransforms(*this);
+            Components.Add(Component);
+        }
+    }
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_ConvertSceneTransforms);
+        ParallelFor(Components.Num(), [&Components](int32 Index)
+        {
+            Components[Index]->ConvertSceneTransforms();
+        });
+    }
+
+    for (UMechanismComponent* Component : Components)
+    {
+        Component->ApplySceneTransforms();
+    }
+
+    // The world actors, including the instancer, may already have ticked this frame
+    if (AVortexMechanismInstancer* Instancer = AVortexMechanismInstancer::Find(World))
+    {
+        Instancer->Flush();
+    }
+}
+
+void FVortexRuntimeModule::SyncSimulationOutputs(UWorld* World)
+{
+    // Pipelined steps kicked in TG_PrePhysics ran alongside the physics
+    WaitForSimulationStep();
+
+    ApplyGraphicNodeUpdates();
+    if (bVHLOutputChangesPending)
+    {
+        DispatchVHLOutputChanges();
+    }
+
+    SyncMechanismComponents(World);
+}
+
+void FVortexRuntimeModule::RecordStepToDisplayLatency()
+{
+    if (LastStepEndTime > LastDisplayedStepEndTime)
+    {
+        SET_FLOAT_STAT(STAT_StepToDisplayLatency, (FPlatformTime::Seconds() - LastStepEndTime) * 1000.0);
+        LastDisplayedStepEndTime = LastStepEndTime;
+    }
+}
+
+bool FVortexRuntimeModule::IsIntegratedInWorldTick(const UWorld* World) const
+{
+    return World != nullptr && TickFunctionsWorld.Get() == World && SyncTickFunction.IsTickFunctionRegistered();
+}
+
+void FVortexRuntimeModule::RegisterTickFunctions(UWorld* World)
+{
+    // Both tick while paused, Vortex is paused and resumed with the world from the step
+    StepTickFunction.bCanEverTick = true;
+    StepTickFunction.bTickEvenWhenPaused = true;
+    StepTickFunction.TickGroup = TG_PrePhysics;
+    StepTickFunction.RegisterTickFunction(World->PersistentLevel);
+
+    SyncTickFunction.bCanEverTick = true;
+    SyncTickFunction.bTickEvenWhenPaused = true;
+    SyncTickFunction.TickGroup = TG_PostPhysics;
+    SyncTickFunction.AddPrerequisite(World, StepTickFunction);
+    SyncTickFunction.RegisterTickFunction(World->PersistentLevel);
+    TickFunctionsWorld = World;
+
+    for (auto& pair : Mechanisms)
+    {
+        for (UMechanismComponent* Component : pair.Value.Components)
+        {
+            if (Component->GetWorld() == World && Component->HasBegunPlay())
+            {
+                SetSyncPrerequisite(Component, true);
+            }
+        }
+    }
+
+    UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::RegisterTickFunctions(): Vortex is stepped in the world tick of <%s>."), *World->GetName());
+}
+
+void FVortexRuntimeModule::UnregisterTickFunctions()
+{
+    if (!StepTickFunction.IsTickFunctionRegistered() && !SyncTickFunction.IsTickFunctionRegistered())
+    {
+        return;
+    }
+
+    if (UWorld* World = TickFunctionsWorld.Get())
+    {
+        for (auto& pair : Mechanisms)
+        {
+            for (UMechanismComponent* Component : pair.Value.Components)
+            {
+                if (Component->GetWorld() == World)
+                {
+                    SetSyncPrerequisite(Component, false);
+                }
+            }
+        }
+    }
+
+    StepTickFunction.UnRegisterTickFunction();
+    SyncTickFunction.UnRegisterTickFunction();
+    SyncTickFunction.GetPrerequisites().Reset();
+    TickFunctionsWorld.Reset();
+}
+
+void FVortexRuntimeModule::OnWorldCleanup(UWorld* World, bool, bool)
+{
+    // Tick functions must not outlive the level they are registered in
+    if (World == TickFunctionsWorld.Get())
+    {
+        UnregisterTickFunctions();
+    }
+
+    ReleaseSensorActors(Lidars, World);
+    ReleaseSensorActors(DepthCameras, World);
+    ReleaseSensorActors(ColorCameras, World);
+}
+
+void FVortexRuntimeModule::SetSyncPrerequisite(UMechanismComponent* Component, bool bEnabled)
+{
+    UWorld* World = TickFunctionsWorld.Get();
+    if (World == nullptr)
+    {
+        return;
+    }
+
+    if (bEnabled)
+    {
+        Component->PrimaryComponentTick.AddPrerequisite(World, SyncTickFunction);
+    }
+    else
+    {
+        Component->PrimaryComponentTick.RemovePrerequisite(World, SyncTickFunction);
+    }
+}
+
+void FVortexStepTickFunction::ExecuteTick(float DeltaTime, ELevelTick, ENamedThreads::Type, const FGraphEventRef&)
+{
+    FVortexRuntimeModule::Get().StepSimulation(DeltaTime);
+}
+
+void FVortexSyncTickFunction::ExecuteTick(float, ELevelTick, ENamedThreads::Type, const FGraphEventRef&)
+{
+    FVortexRuntimeModule& Module = FVortexRuntimeModule::Get();
+    Module.SyncSimulationOutputs(Module.TickFunctionsWorld.Get());
+}
+
+void FVortexRuntimeModule::UpdateMechanismSignificance()
+{
+    SCOPE_CYCLE_COUNTER(STAT_UpdateMechanismSignificance);
+    UWorld* World = GetCurrentWorld();
+
+    TArray<TPair<FVector, float>> Views;
+    if (World != nullptr)
     {
-        if (Component)
+        for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
         {
-            if (auto * world = Component->GetWorld())
+            APlayerController* PlayerController = It->Get();
+            if (PlayerController != nullptr && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager != nullptr)
             {
-                if (auto * actor = Component->GetOwner())
-                {
-                    if (auto * asset = Component->VortexMechanism)
-                    {
-                        return FMD5::HashAnsiString(*FString::Printf(TEXT("%s:%s:%s:%s:%s"),
-                            *UMechanismComponent::StaticClass()->GetName(),
-                            *world->GetName(),
-                            *actor->GetName(),
-                            *Component->GetName(),
-                            *asset->MechanismFilepath.FilePath));
-                    }
-                }
+                FVector Location;
+                FRotator Rotation;
+                PlayerController->GetPlayerViewPoint(Location, Rotation);
+                const float HalfFOV = FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5f);
+                Views.Emplace(Location, FMath::Max(FMath::Tan(HalfFOV), KINDA_SMALL_NUMBER));
             }
         }
-        UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::MakeKey(): Invalid component."));
-        return FString();
     }
 
-    void UnloadAsset(VortexObjectHandle VortexObject)
+    for (auto& pair : Mechanisms)
     {
-        if (!FVortexRuntimeModule::IsIntegrationLoaded())
-        {
-            return;
-        }
-
-        if (VortexObject != nullptr)
+        for (UMechanismComponent* Component : pair.Value.Components)
         {
-            if (VortexUnloadMechanism(VortexObject))
-            {
-                UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::UnloadAsset(): Successfully unloaded Vortex object."));
-            }
-            else
+            if (!Component->HasBegunPlay())
             {
-                UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::UnloadAsset(): Failed to unload Vortex object."));
+                continue;
             }
+
+            // Without a player camera, such as in simulate in editor, everything is significant
+            const bool bEvaluate = Views.Num() > 0 && Component->GetWorld() == World && Component->GetOwner() != nullptr;
+            Component->SetVisualUpdateInterval(bEvaluate ? GetVisualUpdateInterval(Component, Views) : 1);
         }
     }
+}
 
-    void LoadAsset(VortexObjectHandle& VortexObject, UMechanismComponent* Component)
-    {
-        if (!FVortexRuntimeModule::IsIntegrationLoaded())
-            return;
-
-        if (Component->VortexMechanism == nullptr)
-            return;
-
-        FString absoluteFilepath = FPaths::Combine(FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()), Component->VortexMechanism->MechanismFilepath.FilePath);
+int32 FVortexRuntimeModule::GetVisualUpdateInterval(const UMechanismComponent* Component, const TArray<TPair<FVector, float>>& Views) const
+{
+    // Instanced twins are hidden and their instances are batched with those of other actors, only the distance of the instances counts
+    const AActor* Actor = Component->GetOwner();
+    const FBox InstanceBounds = Component->GetGraphicNodeInstanceBounds();
 
-        double translation[3];
-        double rotation[4];
+    // Actors without primitives are never rendered, only their distance counts
+    if (!InstanceBounds.IsValid && Actor->FindComponentByClass<UPrimitiveComponent>() != nullptr && !Actor->WasRecentlyRendered(SignificanceRenderTimeout))
+    {
+        return SignificanceHiddenInterval;
+    }
 
-        AActor* parentActor = Component->GetOwner();
-        VortexIntegrationUtilities::ConvertTransform(parentActor->GetTransform(), translation, rotation);
-        VortexObject = VortexLoadMechanism(TCHAR_TO_UTF8(*absoluteFilepath), translation, rotation);
-        if (VortexObject == nullptr)
-        {
-            UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::LoadAsset(): Unable to load Vortex object from file <%s>."), *absoluteFilepath);
-        }
-        else
-        {
-            UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::LoadAsset(): Successfully loaded Vortex object from file <%s>."), *absoluteFilepath);
-        }
+    FVector Origin;
+    FVector Extent;
+    if (InstanceBounds.IsValid)
+    {
+        InstanceBounds.GetCenterAndExtents(Origin, Extent);
     }
-    
-    void TerrainProviderQuery(VortexTerrainProvider Terrain, const VortexTerrainProviderRequest* request, VortexTerrainProviderResponse* response)
+    else
     {
-        reinterpret_cast<FVortexTerrain*>(Terrain)->Query(request, response);
+        Actor->GetActorBounds(false, Origin, Extent);
     }
+    const float Radius = Extent.Size();
 
-    void TerrainProviderPostQuery(VortexTerrainProvider Terrain)
+    float MinDistance = MAX_flt;
+    float MaxScreenSize = 0.0f;
+    for (const TPair<FVector, float>& View : Views)
     {
-        reinterpret_cast<FVortexTerrain*>(Terrain)->PostQuery();
+        const float Distance = FVector::Dist(View.Key, Origin);
+        MinDistance = FMath::Min(MinDistance, Distance);
+        MaxScreenSize = FMath::Max(MaxScreenSize, Distance > Radius ? Radius / (Distance * View.Value) : 1.0f);
     }
 
-    void TerrainProviderOnDestroy(VortexTerrainProvider Terrain)
+    if (MinDistance <= SignificanceNearDistance)
     {
-        reinterpret_cast<FVortexTerrain*>(Terrain)->OnDestroy();
+        return 1;
+    }
+    if (MinDistance > SignificanceFarDistance || MaxScreenSize < SignificanceMinScreenSize)
+    {
+        return SignificanceFarInterval;
     }
+    return SignificanceMidRangeInterval;
 }
 
-FVortexRuntimeModule::FVortexRuntimeModule()
-    : CurrentWorldContext(nullptr)
-    , VortexIntegrationHandle(nullptr)
-    , AccumulatedTime(0)
-    , VortexPeriod(0.0)
-    , Terrain(nullptr)
+float FVortexRuntimeModule::GetInterpolationAlpha() const
 {
+    if (VortexPeriod <= 0.0)
+    {
+        return 1.0f;
+    }
+
+    // Rendering one step behind the simulation, spread over the steps separating the captured outputs
+    const float Alpha = FMath::Clamp(static_cast<float>(AccumulatedTime / VortexPeriod), 0.0f, 1.0f);
+    return 1.0f - (1.0f - Alpha) / CapturedStepGap;
 }
 
-void FVortexRuntimeModule::RegisterComponent(UMechanismComponent* Component)
+void FVortexRuntimeModule::RecordStepCost(double Duration, int32 StepCount)
 {
-    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+    if (StepCount <= 0)
     {
         return;
     }
 
-    // We want to enforce the fact that a mechanism is expected to be loaded in Editing mode
-    if (VortexGetApplicationMode() != kVortexModeEditing)
-    {
-        UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::RegisterComponent(): The Vortex application MUST be in Editing mode to load Vortex object from file <%s>."), *Component->VortexMechanism->MechanismFilepath.FilePath);
-        return;
-    }
+    // Follow a rising cost right away, such as a heavy mechanism spawning, and a falling one smoothly
+    const double StepCost = Duration / StepCount;
+    AverageStepCost = StepCost > AverageStepCost ? StepCost : FMath::Lerp(AverageStepCost, StepCost, StepCostSmoothingFactor);
+    SET_FLOAT_STAT(STAT_AverageStepCost, AverageStepCost * 1000.0);
+}
 
-    if (Component->VortexObject)
+int32 FVortexRuntimeModule::GetBudgetedStepCount() const
+{
+    if (StepBudget <= 0.0 || AverageStepCost <= 0.0)
     {
-        UE_LOG(LogVortex, Error, TEXT("FVortexRuntimeModule::RegisterComponent(): The VortexObject should be NULL <%s>."), *Component->VortexMechanism->MechanismFilepath.FilePath);
-        return;
+        return MaxUnbudgetedStepCount;
     }
 
-    Component->LoadedMechanismKey = MakeKey(Component);
+    return FMath::Max(1, FMath::FloorToInt(StepBudget / AverageStepCost));
+}
 
-    // Unreal holds multiple components at the same time to represent the same piece of data in different contexts
-    // Components get created and destroyed quite often and sometimes out of order (undo-redo, dragging, etc)
-    // We don't want to immediately unload a Vortex Mechanism if it will be loaded again in the same frame
-    // We keep a short lived pool of recently unloaded mechanisms available for reuse by components sharing an identical
-    // 'key'. See MakeKey() anonymous namespace function comment.
-    VortexObjectHandle* reuseMechanism = MechanismPool.Find(Component->LoadedMechanismKey);
-    if (reuseMechanism != nullptr)
-    {
-        Component->VortexObject = *reuseMechanism;
-        MechanismPool.RemoveSingle(Component->LoadedMechanismKey, Component->VortexObject);
-    }
-    // We are also willing to share the same Vortex Mechanism reference among multiple instances of components sharing an identical
-    // 'key'. See MakeKey() anonymous namespace function comment.
-    if (!Component->VortexObject)
+void FVortexRuntimeModule::RecordRealTimeFactor(int32 StepCount, float DeltaTime)
+{
+    if (DeltaTime > 0.0f)
     {
-        UMechanismComponent** otherComponent = MechanismComponents.Find(Component->LoadedMechanismKey);
-        if (otherComponent != nullptr)
-        {
-            Component->VortexObject = (*otherComponent)->VortexObject;
-        }
-        else
-        {
-            RegisteringMechanismComponent = Component->LoadedMechanismKey;
-            LoadAsset(Component->VortexObject, Component);
-            RegisteringMechanismComponent = nullptr;
-        }
+        RealTimeFactor = FMath::Lerp(RealTimeFactor, StepCount * VortexPeriod / DeltaTime, RealTimeFactorSmoothingFactor);
+        SET_FLOAT_STAT(STAT_RealTimeFactor, RealTimeFactor);
     }
-    // Track the new mechanism component reference
-    MechanismComponents.Add(Component->LoadedMechanismKey, Component);
-    MechanismActors.Add(Component->GetOwner());
 }
 
-void FVortexRuntimeModule::UnregisterComponent(UMechanismComponent* Component, bool bImmediately)
+void FVortexRuntimeModule::CaptureStepOutputs()
 {
-    if (!FVortexRuntimeModule::IsIntegrationLoaded())
+    if (!IsInterpolatingTransforms())
     {
         return;
     }
 
-    MechanismActors.RemoveSingle(Component->GetOwner());
-    MechanismComponents.RemoveSingle(Component->LoadedMechanismKey, Component);
-    // We don't want to unload a Vortex Mechanism if another component is referring to it.
-    if (!MechanismComponents.Contains(Component->LoadedMechanismKey))
+    CapturedStepGap = FMath::Max(1, StepsSinceCapture);
+    StepsSinceCapture = 0;
+
+    for (auto& pair : Mechanisms)
     {
-        if (bImmediately)
-        {
-            RegisteringMechanismComponent = Component->LoadedMechanismKey;
-            // On EndPlay we want to unload a Vortex Mechanism immediately to guarantee no state leaks from play to play.
-            UnloadAsset(Component->VortexObject);
-            RegisteringMechanismComponent = nullptr;
-        }
-        else
+        for (UMechanismComponent* Component : pair.Value.Components)
         {
-            // We don't want to immediately unload a Vortex Mechanism if it will be loaded again in the same frame
-            MechanismPool.Add(Component->LoadedMechanismKey, Component->VortexObject);
+            Component->CaptureStepOutputs();
         }
     }
-
-    Component->onComponentUnregistered();
-
-    Component->LoadedMechanismKey = "";
-    Component->VortexObject = nullptr;
-}
-
-void FVortexRuntimeModule::UnregisterAllComponents(FString LoadedMechanismKey)
-{
-    // On EndPlay we want to unload a Vortex Mechanism immediately to guarantee no state leaks from play to play.
-    TArray<UMechanismComponent*> siblings;
-    MechanismComponents.MultiFind(LoadedMechanismKey, siblings);
-    for (auto& sibling : siblings)
-    {
-        // Unload immediately
-        UnregisterComponent(sibling, true);
-    }
 }
 
 void FVortexRuntimeModule::AssociateLidarToRegisteringComponent(const GraphicsLidarInfo& lidarInfo)
 {
-    if (!RegisteringMechanismComponent.IsEmpty())
+    if (RegisteringMechanism.IsValid())
     {
-        if (!MechanismLidars.Contains(RegisteringMechanismComponent))
+        if (!MechanismLidars.Contains(RegisteringMechanism))
         {
-            MechanismLidars.Add(RegisteringMechanismComponent);
+            MechanismLidars.Add(RegisteringMechanism);
         }
-        MechanismLidars[RegisteringMechanismComponent].Add(lidarInfo);
+        MechanismLidars[RegisteringMechanism].Add(lidarInfo);
         Lidars.Add(lidarInfo.id) = nullptr;
     }
 }
 
 void FVortexRuntimeModule::UnassociateLidarFromUnregisteringComponent(uint64_t LidarId)
 {
-    if (!RegisteringMechanismComponent.IsEmpty())
+    if (RegisteringMechanism.IsValid())
     {
         if (Lidars.Contains(LidarId)) 
         {
-            /*if (Lidars[LidarId]) 
+            // Only the sensor actors of a pooled mechanism are still around when it is unloaded
+            if (Lidars[LidarId])
             {
-                RegisteringMechanismComponent->GetWorld()->DestroyActor(static_cast<AActor*>(Lidars[LidarId]));
-            }*/
+                Lidars[LidarId]->Destroy();
+            }
             Lidars.Remove(LidarId);
         }
-        if (MechanismLidars.Contains(RegisteringMechanismComponent)) 
+        if (MechanismLidars.Contains(RegisteringMechanism)) 
         {
-            for (int32 i = 0; i < MechanismLidars[RegisteringMechanismComponent].Num(); ++i)
+            for (int32 i = 0; i < MechanismLidars[RegisteringMechanism].Num(); ++i)
             {
-                if (MechanismLidars[RegisteringMechanismComponent][i].id == LidarId)
+                if (MechanismLidars[RegisteringMechanism][i].id == LidarId)
                 {
-                    MechanismLidars[RegisteringMechanismComponent].RemoveAt(i);
+                    MechanismLidars[RegisteringMechanism].RemoveAt(i);
                     break;
                 }
             }
-            if (MechanismLidars[RegisteringMechanismComponent].Num() == 0)
+            if (MechanismLidars[RegisteringMechanism].Num() == 0)
             {
-                MechanismLidars.Remove(RegisteringMechanismComponent);
+                MechanismLidars.Remove(RegisteringMechanism);
             }
         }
     }
@@ -455,38 +1463,42 @@ void FVortexRuntimeModule::UnassociateLidarFromUnregisteringComponent(uint64_t L
 
 void FVortexRuntimeModule::AssociateDepthCameraToRegisteringComponent(const GraphicsDepthCameraInfo& depthCameraInfo)
 {
-    if (!RegisteringMechanismComponent.IsEmpty())
+    if (RegisteringMechanism.IsValid())
     {
-        if (!MechanismDepthCamera.Contains(RegisteringMechanismComponent))
+        if (!MechanismDepthCamera.Contains(RegisteringMechanism))
         {
-            MechanismDepthCamera.Add(RegisteringMechanismComponent);
+            MechanismDepthCamera.Add(RegisteringMechanism);
         }
-        MechanismDepthCamera[RegisteringMechanismComponent].Add(depthCameraInfo);
+        MechanismDepthCamera[RegisteringMechanism].Add(depthCameraInfo);
         DepthCameras.Add(depthCameraInfo.id) = nullptr;
     }
 }
 
 void FVortexRuntimeModule::UnassociateDepthCameraFromUnregisteringComponent(uint64_t DepthCameraId)
 {
-    if (!RegisteringMechanismComponent.IsEmpty())
+    if (RegisteringMechanism.IsValid())
     {
         if (DepthCameras.Contains(DepthCameraId))
         {
+            if (DepthCameras[DepthCameraId])
+            {
+                DepthCameras[DepthCameraId]->Destroy();
+            }
             DepthCameras.Remove(DepthCameraId);
         }
-        if (MechanismDepthCamera.Contains(RegisteringMechanismComponent))
+        if (MechanismDepthCamera.Contains(RegisteringMechanism))
         {
-            for (int32 i = 0; i < MechanismDepthCamera[RegisteringMechanismComponent].Num(); ++i)
+            for (int32 i = 0; i < MechanismDepthCamera[RegisteringMechanism].Num(); ++i)
             {
-                if (MechanismDepthCamera[RegisteringMechanismComponent][i].id == DepthCameraId)
+                if (MechanismDepthCamera[RegisteringMechanism][i].id == DepthCameraId)
                 {
-                    MechanismDepthCamera[RegisteringMechanismComponent].RemoveAt(i);
+                    MechanismDepthCamera[RegisteringMechanism].RemoveAt(i);
                     break;
                 }
             }
-            if (MechanismDepthCamera[RegisteringMechanismComponent].Num() == 0)
+            if (MechanismDepthCamera[RegisteringMechanism].Num() == 0)
             {
-                MechanismDepthCamera.Remove(RegisteringMechanismComponent);
+                MechanismDepthCamera.Remove(RegisteringMechanism);
             }
         }
     }
@@ -494,38 +1506,42 @@ void FVortexRuntimeModule::UnassociateDepthCameraFromUnregisteringComponent(uint
 
 void FVortexRuntimeModule::AssociateColorCameraToRegisteringComponent(const GraphicsColorCameraInfo& colorCameraInfo)
 {
-    if (!RegisteringMechanismComponent.IsEmpty())
+    if (RegisteringMechanism.IsValid())
     {
-        if (!MechanismColorCamera.Contains(RegisteringMechanismComponent))
+        if (!MechanismColorCamera.Contains(RegisteringMechanism))
         {
-            MechanismColorCamera.Add(RegisteringMechanismComponent);
+            MechanismColorCamera.Add(RegisteringMechanism);
         }
-        MechanismColorCamera[RegisteringMechanismComponent].Add(colorCameraInfo);
+        MechanismColorCamera[RegisteringMechanism].Add(colorCameraInfo);
         ColorCameras.Add(colorCameraInfo.id) = nullptr;
     }
 }
 
 void FVortexRuntimeModule::UnassociateColorCameraFromUnregisteringComponent(uint64_t ColorCameraId)
 {
-    if (!RegisteringMechanismComponent.IsEmpty())
+    if (RegisteringMechanism.IsValid())
     {
         if (ColorCameras.Contains(ColorCameraId))
         {
+            if (ColorCameras[ColorCameraId])
+            {
+                ColorCameras[ColorCameraId]->Destroy();
+            }
             ColorCameras.Remove(ColorCameraId);
         }
-        if (MechanismColorCamera.Contains(RegisteringMechanismComponent))
+        if (MechanismColorCamera.Contains(RegisteringMechanism))
         {
-            for (int32 i = 0; i < MechanismColorCamera[RegisteringMechanismComponent].Num(); ++i)
+            for (int32 i = 0; i < MechanismColorCamera[RegisteringMechanism].Num(); ++i)
             {
-                if (MechanismColorCamera[RegisteringMechanismComponent][i].id == ColorCameraId)
+                if (MechanismColorCamera[RegisteringMechanism][i].id == ColorCameraId)
                 {
-                    MechanismColorCamera[RegisteringMechanismComponent].RemoveAt(i);
+                    MechanismColorCamera[RegisteringMechanism].RemoveAt(i);
                     break;
                 }
             }
-            if (MechanismColorCamera[RegisteringMechanismComponent].Num() == 0)
+            if (MechanismColorCamera[RegisteringMechanism].Num() == 0)
             {
-                MechanismColorCamera.Remove(RegisteringMechanismComponent);
+                MechanismColorCamera.Remove(RegisteringMechanism);
             }
         }
     }
@@ -533,6 +1549,21 @@ void FVortexRuntimeModule::UnassociateColorCameraFromUnregisteringComponent(uint
 
 void FVortexRuntimeModule::BeginPlay(UMechanismComponent* Component)
 {
+    if (bCentralizedTick)
+    {
+        CentrallyTickedComponents.AddUnique(Component);
+    }
+
+    // Components read the outputs once they are synchronized, in the same frame as the step
+    if (bTickGroupIntegration)
+    {
+        Component->SetTickGroup(TG_PostPhysics);
+        if (IsIntegratedInWorldTick(Component->GetWorld()))
+        {
+            SetSyncPrerequisite(Component, true);
+        }
+    }
+
     if (MechanismLidars.Contains(Component->LoadedMechanismKey))
     {
         const TArray<GraphicsLidarInfo>& mechanismLidars = MechanismLidars[Component->LoadedMechanismKey];
@@ -559,6 +1590,11 @@ void FVortexRuntimeModule::BeginPlay(UMechanismComponent* Component)
                     UGameplayStatics::FinishSpawningActor(Lidars[lidar.id], pose);
                 }
             }
+            else
+            {
+                // Kept while the mechanism was pooled
+                SetSensorActorActive(Lidars[lidar.id], true);
+            }
         }
     }
 
@@ -582,6 +1618,10 @@ void FVortexRuntimeModule::BeginPlay(UMechanismComponent* Component)
                     depthCameraActorComponent->SetWorldTransform(pose);
                 }
             }
+            else
+            {
+                SetSensorActorActive(DepthCameras[depthCamera.id], true);
+            }
         }
     }
 
@@ -604,18 +1644,36 @@ void FVortexRuntimeModule::BeginPlay(UMechanismComponent* Component)
                     colorCameraActorComponent->SetWorldTransform(pose);
                 }
             }
+            else
+            {
+                SetSensorActorActive(ColorCameras[colorCamera.id], true);
+            }
         }
     }
 }
 
-void FVortexRuntimeModule::EndPlay(UMechanismComponent* Component)
+void FVortexRuntimeModule::EndPlay(UMechanismComponent* Component, EEndPlayReason::Type EndPlayReason)
 {
+    CentrallyTickedComponents.RemoveSingleSwap(Component);
+    if (IsIntegratedInWorldTick(Component->GetWorld()))
+    {
+        SetSyncPrerequisite(Component, false);
+    }
+
+    // The world of a streamed level outlives it, the sensor actors of its pooled mechanisms wait there to be reused.
+    // Otherwise the sensor actors are spawned again from the mechanism sensors by BeginPlay().
+    const bool bKeepSensorActors = EndPlayReason == EEndPlayReason::RemovedFromWorld && ShouldPoolMechanismOnEndPlay(EndPlayReason);
+
     if (MechanismLidars.Contains(Component->LoadedMechanismKey))
     {
         const TArray<GraphicsLidarInfo>& mechanismLidars = MechanismLidars[Component->LoadedMechanismKey];
         for (const auto& lidar : mechanismLidars)
         {
-            if (Lidars[lidar.id])
+            if (Lidars[lidar.id] && bKeepSensorActors)
+            {
+                SetSensorActorActive(Lidars[lidar.id], false);
+            }
+            else if (Lidars[lidar.id])
             {
                 Component->GetWorld()->DestroyActor(static_cast<AActor*>(Lidars[lidar.id]));
                 Lidars[lidar.id] = nullptr;
@@ -628,7 +1686,11 @@ void FVortexRuntimeModule::EndPlay(UMechanismComponent* Component)
         const TArray<GraphicsDepthCameraInfo>& mechanismDepthCameras = MechanismDepthCamera[Component->LoadedMechanismKey];
         for (const auto& depthCamera : mechanismDepthCameras)
         {
-            if (DepthCameras[depthCamera.id])
+            if (DepthCameras[depthCamera.id] && bKeepSensorActors)
+            {
+                SetSensorActorActive(DepthCameras[depthCamera.id], false);
+            }
+            else if (DepthCameras[depthCamera.id])
             {
                 Component->GetWorld()->DestroyActor(static_cast<AActor*>(DepthCameras[depthCamera.id]));
                 DepthCameras[depthCamera.id] = nullptr;
@@ -641,7 +1703,11 @@ void FVortexRuntimeModule::EndPlay(UMechanismComponent* Component)
         const TArray<GraphicsColorCameraInfo>& mechanismColorCameras = MechanismColorCamera[Component->LoadedMechanismKey];
         for (const auto& colorCamera : mechanismColorCameras)
         {
-            if (ColorCameras[colorCamera.id])
+            if (ColorCameras[colorCamera.id] && bKeepSensorActors)
+            {
+                SetSensorActorActive(ColorCameras[colorCamera.id], false);
+            }
+            else if (ColorCameras[colorCamera.id])
             {
                 Component->GetWorld()->DestroyActor(static_cast<AActor*>(ColorCameras[colorCamera.id]));
                 ColorCameras[colorCamera.id] = nullptr;
@@ -650,6 +1716,11 @@ void FVortexRuntimeModule::EndPlay(UMechanismComponent* Component)
     }
 }
 
+bool FVortexRuntimeModule::ShouldPoolMechanismOnEndPlay(EEndPlayReason::Type EndPlayReason) const
+{
+    return EndPlayReason == EEndPlayReason::RemovedFromWorld || (EndPlayReason == EEndPlayReason::EndPlayInEditor && bWarmPlayInEditorRestart);
+}
+
 void FVortexRuntimeModule::UpdateLidar(GraphicsLidarInfo& lidarInfo)
 {
     if (Lidars[lidarInfo.id])
@@ -808,6 +1879,12 @@ void FVortexRuntimeModule::StartupModule()
                 callbacks.lidarNotification = VortexLidarCallback;
                 callbacks.depthCameraNotification = VortexDepthCameraCallback;
                 callbacks.colorCameraNotification = VortexColorCameraCallback;
+                callbacks.VHLNotification = VortexVHLCallback;
+                bGraphicNodeNotifications = GetDefault<UVortexSettings>()->EnableGraphicNodeNotifications;
+                if (bGraphicNodeNotifications)
+                {
+                    callbacks.nodeNotification = VortexGraphicNodeCallback;
+                }
                 ::GraphicsRegisterCallbacks(&callbacks);
                 ValidateUnrealAndVortexFrameRates();
 
@@ -816,6 +1893,56 @@ void FVortexRuntimeModule::StartupModule()
                 VortexPeriod = VortexGetSimulationFrameRate() >= 0.0 ? 1.0 / VortexGetSimulationFrameRate() : 0.0;
                 TickDelegate = FTickerDelegate::CreateRaw(this, &FVortexRuntimeModule::Tick);
                 TickDelegateHandle = FTicker::GetCoreTicker().AddTicker(TickDelegate);
+                bInterpolateTransforms = GetDefault<UVortexSettings>()->EnableTransformInterpolation;
+                StepBudget = GetDefault<UVortexSettings>()->StepBudget / 1000.0;
+                CatchUpBehavior = GetDefault<UVortexSettings>()->CatchUpBehavior;
+                MaxStepDebt = FMath::Max(1, GetDefault<UVortexSettings>()->MaxStepDebt);
+                AverageStepCost = 0.0;
+                BatchStepsPerTick = FMath::Max(0, GetDefault<UVortexSettings>()->BatchStepsPerTick);
+                BatchVisualSyncInterval = FMath::Max(1, GetDefault<UVortexSettings>()->BatchVisualSyncInterval);
+                bAsynchronousMechanismLoading = GetDefault<UVortexSettings>()->EnableAsynchronousMechanismLoading;
+                MechanismLoadBudget = GetDefault<UVortexSettings>()->MechanismLoadBudget / 1000.0;
+                bWarmPlayInEditorRestart = GetDefault<UVortexSettings>()->EnableWarmPlayInEditorRestart;
+                MechanismPoolLifetime = FMath::Max(0.0f, GetDefault<UVortexSettings>()->MechanismPoolLifetime);
+                MechanismPoolCapacity = FMath::Max(0, GetDefault<UVortexSettings>()->MechanismPoolCapacity);
+                MechanismUnloadBudget = GetDefault<UVortexSettings>()->MechanismUnloadBudget / 1000.0;
+#if WITH_EDITOR
+                bLazyEditorMechanismLoading = GIsEditor && GetDefault<UVortexSettings>()->EnableLazyEditorMechanismLoading;
+                EditorMechanismLoadDistanceSquared = FMath::Square(FMath::Max(0.0, (double)GetDefault<UVortexSettings>()->EditorMechanismLoadDistance));
+#endif
+
+                if (GetDefault<UVortexSettings>()->EnablePipelinedSimulation)
+                {
+                    UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::StartupModule(): Vortex steps will run on a dedicated simulation thread."));
+                    SimulationThread = new FVortexSimulationThread();
+                    WorldTickStartBinding = FWorldDelegates::OnWorldTickStart.AddRaw(this, &FVortexRuntimeModule::OnWorldTickStart);
+                }
+
+                bSignificanceUpdates = GetDefault<UVortexSettings>()->EnableSignificanceBasedUpdates;
+                SignificanceNearDistance = GetDefault<UVortexSettings>()->SignificanceNearDistance;
+                SignificanceFarDistance = FMath::Max(SignificanceNearDistance, GetDefault<UVortexSettings>()->SignificanceFarDistance);
+                SignificanceMinScreenSize = GetDefault<UVortexSettings>()->SignificanceMinScreenSize;
+                SignificanceMidRangeInterval = FMath::Max(1, GetDefault<UVortexSettings>()->SignificanceMidRangeInterval);
+                SignificanceFarInterval = FMath::Max(1, GetDefault<UVortexSettings>()->SignificanceFarInterval);
+                SignificanceHiddenInterval = FMath::Max(0, GetDefault<UVortexSettings>()->SignificanceHiddenInterval);
+
+                bCentralizedTick = GetDefault<UVortexSettings>()->EnableCentralizedMechanismTick;
+                if (bCentralizedTick)
+                {
+                    UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::StartupModule(): Playing mechanism components will be synchronized by the runtime module instead of ticking individually."));
+                }
+
+                // Also closes the step to display latency measurement, in every mode
+                WorldPostActorTickBinding = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FVortexRuntimeModule::OnWorldPostActorTick);
+
+                // Also releases the sensor actors left in a world by pooled mechanisms
+                WorldCleanupBinding = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FVortexRuntimeModule::OnWorldCleanup);
+
+                bTickGroupIntegration = GetDefault<UVortexSettings>()->EnableTickGroupIntegration;
+                if (bTickGroupIntegration)
+                {
+                    UE_LOG(LogVortex, Display, TEXT("FVortexRuntimeModule::StartupModule(): Vortex will be stepped in TG_PrePhysics and synchronized in TG_PostPhysics of the simulated world."));
+                }
 
                 // Get the total number of Vortex materials
                 std::vector<VortexMaterial> VortexMaterials;
@@ -863,6 +1990,7 @@ void FVortexRuntimeModule::StartupModule()
 
                 // Bind events on PIE (Play-in-Editor) end
                 PieEndedEventBinding = FEditorDelegates::PrePIEEnded.AddRaw(this, &FVortexRuntimeModule::OnPieEnded);
+                PieStartedEventBinding = FEditorDelegates::PostPIEStarted.AddRaw(this, &FVortexRuntimeModule::OnPieStarted);
                 PieSingleStepEventBinding = FEditorDelegates::SingleStepPIE.AddRaw(this, &FVortexRuntimeModule::OnPieSingleStep);
                 FEditorDelegates::OnShutdownPostPackagesSaved.AddStatic([]() {
                     // Closing and saving while playing doesn't call UVortexApplicationBlueprintLib::StopSimulation
@@ -927,13 +2055,40 @@ bool FVortexRuntimeModule::Tick(float deltaTime)
         LastFixedFrameRate = GEngine->FixedFrameRate;
     }
 #endif
-    
-    // Flush deferred Mechanism unload pool
-    for (auto& pair : MechanismPool)
+
+    LoadDeferredEditorMechanisms();
+
+    if (bTickGroupIntegration)
     {
-        UnloadAsset(pair.Value);
+        // The tick functions follow the simulated world
+        UWorld* World = GetCurrentWorld();
+        if (World != TickFunctionsWorld.Get())
+        {
+            UnregisterTickFunctions();
+            if (World != nullptr)
+            {
+                RegisterTickFunctions(World);
+            }
+        }
+
+        if (IsIntegratedInWorldTick(World))
+        {
+            return true;
+        }
     }
-    MechanismPool.Empty();
+
+    StepSimulation(deltaTime);
+    return true;
+}
+
+void FVortexRuntimeModule::StepSimulation(float deltaTime)
+{
+    // In pipelined mode, the previous steps are normally joined before the world tick. Make sure of it before touching Vortex.
+    WaitForSimulationStep();
+
+    EvictPooledMechanisms();
+
+    LoadPendingMechanisms();
     SCOPE_CYCLE_COUNTER(STAT_ModuleTick);
     // Paused/Resume simulation BEFORE updating the application, so it takes effect right away (it takes one step to be active).
     if (GetCurrentWorld() != nullptr && GetCurrentWorld()->IsPaused() != VortexIsPaused())
@@ -941,21 +2096,142 @@ bool FVortexRuntimeModule::Tick(float deltaTime)
         VortexPause(GetCurrentWorld()->IsPaused());
     }
 
-    AccumulatedTime += deltaTime;
-    // If the accummulated time is too big, we don't try to catch up
-    if (AccumulatedTime >= OutstandingPeriodFactor * VortexPeriod)
+    if (bSignificanceUpdates && FPlatformTime::Seconds() - LastSignificanceUpdateTime >= SignificanceUpdatePeriod)
     {
-        AccumulatedTime = VortexPeriod;
+        UpdateMechanismSignificance();
+        LastSignificanceUpdateTime = FPlatformTime::Seconds();
     }
-    
-    while (AccumulatedTime >= VortexPeriod)
+
+    int32 StepCount = 0;
+    int32 StepDebt = 0;
+    if (IsBatchMode())
+    {
+        // Batch mode: a fixed number of steps per tick, regardless of the wall clock time.
+        // Visuals are only synchronized once every BatchVisualSyncInterval steps.
+        StepCount = BatchStepsPerTick;
+        AccumulatedTime = 0.0;
+        StepsSinceVisualSync += StepCount;
+        bSyncVisuals = StepsSinceVisualSync >= BatchVisualSyncInterval;
+        if (bSyncVisuals)
+        {
+            StepsSinceVisualSync = 0;
+        }
+    }
+    else
+    {
+        // Editing mode steps are much cheaper than simulating ones, the cost is measured again when the mode changes
+        const bool bSimulating = VortexGetApplicationMode() == kVortexModeSimulating;
+        if (bSimulating != bStepCostSimulating)
+        {
+            bStepCostSimulating = bSimulating;
+            AverageStepCost = 0.0;
+        }
+
+        AccumulatedTime += deltaTime * TargetSpeedMultiplier;
+
+        while (AccumulatedTime >= VortexPeriod)
+        {
+            ++StepCount;
+            AccumulatedTime -= VortexPeriod;
+        }
+
+        // Never spend more than the step budget in a frame, otherwise a slow frame makes the next one owe even more steps.
+        // The steps that did not fit are either carried over to the next frames, up to MaxStepDebt, or dropped.
+        const int32 BudgetedStepCount = GetBudgetedStepCount();
+        if (StepCount > BudgetedStepCount)
+        {
+            if (CatchUpBehavior == EVortexCatchUpBehavior::SlowMotion)
+            {
+                StepDebt = FMath::Min(StepCount - BudgetedStepCount, MaxStepDebt);
+                AccumulatedTime += StepDebt * VortexPeriod;
+            }
+            StepCount = BudgetedStepCount;
+        }
+    }
+    SET_DWORD_STAT(STAT_StepsPerFrame, StepCount);
+    SET_DWORD_STAT(STAT_StepDebt, StepDebt);
+
+    if (StepCount == 0)
+    {
+        RecordRealTimeFactor(0, deltaTime);
+        return;
+    }
+
+    // Batched VHL inputs are sent once, right before the steps of this frame
+    FlushVHLBatchInputs();
+
+    if (CanStepOnSimulationThread())
+    {
+        // Pipelined mode: the steps run while the game thread finishes this frame and starts the next one.
+        // They are joined in OnWorldTickStart(), or earlier by any game thread code calling into Vortex.
+        if (bSyncVisuals)
+        {
+            FlushPersistentDebugLines(GetCurrentWorld());
+        }
+        PipelinedStepsDeltaTime = deltaTime;
+        SimulationThread->Kick(StepCount, GetInputCommandQueues(), GetOutputSnapshotChannels());
+        return;
+    }
+
+    const TArray<FVortexInputCommandQueuePtr> InputCommandQueues = GetInputCommandQueues();
+    const TArray<FVortexOutputSnapshotChannelPtr> OutputSnapshotChannels = GetOutputSnapshotChannels();
+    const double StepsStartTime = FPlatformTime::Seconds();
+    bool bLastStepCaptured = false;
+    int32 Step = 0;
+    for (; Step < StepCount; ++Step)
     {
-        FlushPersistentDebugLines(GetCurrentWorld());
+        // The average cost may underestimate the steps of this frame, the measured time has the last word
+        if (Step > 0 && StepBudget > 0.0 && !IsBatchMode() && FPlatformTime::Seconds() - StepsStartTime >= StepBudget)
+        {
+            const int32 SkippedStepCount = StepCount - Step;
+            if (CatchUpBehavior == EVortexCatchUpBehavior::SlowMotion)
+            {
+                AccumulatedTime += FMath::Min(SkippedStepCount, FMath::Max(0, MaxStepDebt - StepDebt)) * VortexPeriod;
+            }
+            SET_DWORD_STAT(STAT_StepsPerFrame, Step);
+
+            if (!bLastStepCaptured)
+            {
+                CaptureStepOutputs();
+            }
+            break;
+        }
+
+        // Between visual syncs, debug drawings accumulate until the next sync
+        if (bSyncVisuals)
+        {
+            FlushPersistentDebugLines(GetCurrentWorld());
+        }
+        ApplyQueuedVHLInputs();
+        for (const FVortexInputCommandQueuePtr& Queue : InputCommandQueues)
+        {
+            Queue->Drain();
+        }
+        const double StepStartTime = FPlatformTime::Seconds();
         VortexUpdateApplication();
-        AccumulatedTime -= VortexPeriod;
+        RecordStepCost(FPlatformTime::Seconds() - StepStartTime, 1);
+        ++StepsSinceCapture;
+        for (const FVortexOutputSnapshotChannelPtr& Channel : OutputSnapshotChannels)
+        {
+            Channel->Publish();
+        }
+
+        // Only the last two steps of the frame are needed to interpolate
+        bLastStepCaptured = Step >= StepCount - 2;
+        if (bLastStepCaptured)
+        {
+            CaptureStepOutputs();
+        }
     }
+    LastStepEndTime = FPlatformTime::Seconds();
 
-    return true;
+    // The loop may have stopped on the step budget before running all the planned steps
+    RecordRealTimeFactor(Step, deltaTime);
+
+    // Batched VHL outputs are gathered once, right after the steps of this frame
+    GatherVHLBatchOutputs();
+    ApplyGraphicNodeUpdates();
+    DispatchVHLOutputChanges();
 }
 
 UWorld* FVortexRuntimeModule::GetCurrentWorld() const
@@ -970,7 +2246,13 @@ UWorld* FVortexRuntimeModule::GetCurrentWorld() const
 
 const TArray<AActor*>& FVortexRuntimeModule::GetMechanismActors() const
 {
-    return MechanismActors;
+    if (bMechanismActorListDirty)
+    {
+        MechanismActors.GenerateKeyArray(MechanismActorList);
+        bMechanismActorListDirty = false;
+    }
+
+    return MechanismActorList;
 }
 
 FString FVortexRuntimeModule::GetVortexMaterialFromPhysicalMaterial(UPhysicalMaterial* PhysicalMaterial) const
@@ -1067,11 +2349,20 @@ void FVortexRuntimeModule::ShutdownVortex()
 
 #if WITH_EDITOR
     FEditorDelegates::PrePIEEnded.Remove(PieEndedEventBinding);
+    FEditorDelegates::PostPIEStarted.Remove(PieStartedEventBinding);
     FEditorDelegates::SingleStepPIE.Remove(PieSingleStepEventBinding);
 #endif
 
     FTicker::GetCoreTicker().RemoveTicker(TickDelegateHandle);
 
+    FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartBinding);
+    FWorldDelegates::OnWorldPostActorTick.Remove(WorldPostActorTickBinding);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupBinding);
+    UnregisterTickFunctions();
+    WaitForSimulationStep();
+    delete SimulationThread;
+    SimulationThread = nullptr;
+
     if (IsIntegrationLoaded())
     {
         VortexDestroyApplication();
@@ -1092,6 +2383,8 @@ void FVortexRuntimeModule::OnPieEnded(bool)
         return;
     }
 
+    WaitForSimulationStep();
+
     UWorld* pieWorld = GEditor->GetPIEWorldContext()->World();
 #if WITH_EDITORONLY_DATA
     bool isGameWorld = !IsRunningCommandlet() && pieWorld->IsGameWorld();
@@ -1104,6 +2397,42 @@ void FVortexRuntimeModule::OnPieEnded(bool)
             VortexPause(false);
         }
     }
+
+    // The mechanisms kept for the next session are reset to their authored state before they are pooled:
+    // leaving Simulating mode restores the content Vortex had in Editing mode
+    if (bWarmPlayInEditorRestart)
+    {
+        bEndingPlayInEditor = true;
+        if (VortexGetApplicationMode() != kVortexModeEditing)
+        {
+            UVortexApplicationBlueprintLib::StopSimulation(nullptr);
+        }
+    }
+}
+
+void FVortexRuntimeModule::OnPieStarted(bool)
+{
+    bEndingPlayInEditor = false;
+
+    // The mechanisms kept from the previous session that were not reused are now evicted like any other pooled mechanism
+    TArray<FPooledMechanism> Released;
+    MechanismPool.RemoveAll([&Released](const FPooledMechanism& Pooled)
+    {
+        if (Pooled.bRetainedForRestart)
+        {
+            Released.Add(Pooled);
+            return true;
+        }
+        return false;
+    });
+
+    const double Now = FPlatformTime::Seconds();
+    for (FPooledMechanism& Pooled : Released)
+    {
+        Pooled.bRetainedForRestart = false;
+        Pooled.ReleaseTime = Now;
+    }
+    MechanismPool.Append(Released);
 }
 
 void FVortexRuntimeModule::OnPieSingleStep(bool)
@@ -1113,6 +2442,7 @@ void FVortexRuntimeModule::OnPieSingleStep(bool)
         return;
     }
 
+    WaitForSimulationStep();
     VortexStepOnce();
 }
 
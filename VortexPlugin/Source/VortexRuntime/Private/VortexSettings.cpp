@@ -24,6 +24,31 @@ UVortexSettings::UVortexSettings()
     , TerrainPagingTileSizeXY(50.0)
     , TerrainPagingLookAheadTime(1.0)
     , TerrainPagingSafetyBandSize(1.0)
+    , EnablePipelinedSimulation(false)
+    , EnableTransformInterpolation(false)
+    , EnableGraphicNodeNotifications(false)
+    , EnableCentralizedMechanismTick(false)
+    , EnableTickGroupIntegration(false)
+    , StepBudget(10.0f)
+    , CatchUpBehavior(EVortexCatchUpBehavior::SlowMotion)
+    , MaxStepDebt(4)
+    , BatchStepsPerTick(0)
+    , BatchVisualSyncInterval(1)
+    , EnableSignificanceBasedUpdates(false)
+    , SignificanceNearDistance(5000.0f)
+    , SignificanceFarDistance(20000.0f)
+    , SignificanceMinScreenSize(0.02f)
+    , SignificanceMidRangeInterval(4)
+    , SignificanceFarInterval(16)
+    , SignificanceHiddenInterval(64)
+    , EnableAsynchronousMechanismLoading(false)
+    , MechanismLoadBudget(8.0f)
+    , MechanismPoolLifetime(0.0f)
+    , EnableWarmPlayInEditorRestart(false)
+    , MechanismPoolCapacity(16)
+    , MechanismUnloadBudget(4.0f)
+    , EnableLazyEditorMechanismLoading(false)
+    , EditorMechanismLoadDistance(10000.0f)
     , IsMaterialMappingErrorBeingShown(false)
 {
 }
@@ -0,0 +1,112 @@
+#include "VortexSimulationThread.h"
+#include "VortexRuntime.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+#include "VortexIntegration/VortexIntegration.h"
+
+DECLARE_CYCLE_STAT(TEXT("SimulationThreadStep"), STAT_SimulationThreadStep, STATGROUP_VortexRuntimeModule);
+
+FVortexSimulationThread::FVortexSimulationThread()
+    : Thread(nullptr)
+    , KickEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    , DoneEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    , bStopping(false)
+    , PendingStepCount(0)
+    , LastStepsDuration(0.0)
+    , LastStepsEndTime(0.0)
+    , LastStepCount(0)
+    , bBusy(false)
+{
+    Thread = FRunnableThread::Create(this, TEXT("VortexSimulationThread"), 0, TPri_AboveNormal);
+}
+
+FVortexSimulationThread::~FVortexSimulationThread()
+{
+    // Never leave a step running while the thread is torn down
+    Wait();
+
+    if (Thread != nullptr)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FPlatformProcess::ReturnSynchEventToPool(KickEvent);
+    KickEvent = nullptr;
+    FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+    DoneEvent = nullptr;
+}
+
+void FVortexSimulationThread::Kick(int32 StepCount, TArray<FVortexInputCommandQueuePtr>&& InputCommandQueues, TArray<FVortexOutputSnapshotChannelPtr>&& OutputSnapshotChannels)
+{
+    check(IsInGameThread());
+    check(!bBusy);
+
+    if (StepCount <= 0)
+    {
+        return;
+    }
+
+    bBusy = true;
+    InputQueues = MoveTemp(InputCommandQueues);
+    SnapshotChannels = MoveTemp(OutputSnapshotChannels);
+    PendingStepCount = StepCount;
+    KickEvent->Trigger();
+}
+
+void FVortexSimulationThread::Wait()
+{
+    if (bBusy)
+    {
+        DoneEvent->Wait();
+        bBusy = false;
+    }
+}
+
+uint32 FVortexSimulationThread::Run()
+{
+    while (!bStopping)
+    {
+        KickEvent->Wait();
+        if (bStopping)
+        {
+            break;
+        }
+
+        const int32 StepCount = PendingStepCount.Exchange(0);
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Step = 0; Step < StepCount; ++Step)
+        {
+            SCOPE_CYCLE_COUNTER(STAT_SimulationThreadStep);
+            for (const FVortexInputCommandQueuePtr& Queue : InputQueues)
+            {
+                Queue->Drain();
+            }
+            VortexUpdateApplication();
+            for (const FVortexOutputSnapshotChannelPtr& Channel : SnapshotChannels)
+            {
+                Channel->Publish();
+            }
+        }
+
+        // Do not keep the channels alive, so the ones released by their subscribers can be pruned on the next frame
+        SnapshotChannels.Reset();
+
+        LastStepsEndTime = FPlatformTime::Seconds();
+        LastStepsDuration = LastStepsEndTime - StartTime;
+        LastStepCount = StepCount;
+        DoneEvent->Trigger();
+    }
+
+    return 0;
+}
+
+void FVortexSimulationThread::Stop()
+{
+    bStopping = true;
+    KickEvent->Trigger();
+}
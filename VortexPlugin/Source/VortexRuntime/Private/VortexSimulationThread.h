@@ -0,0 +1,94 @@
+#pragma once
+//Copyright(c) 2019 CM Labs Simulations Inc. All rights reserved.
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of
+//the sample code software and associated documentation files (the "Software"), to deal with
+//the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies
+//of the Software, and to permit persons to whom the Software is furnished to
+//do so, subject to the following conditions :
+//
+//Redistributions of source code must retain the above copyright notice,
+//this list of conditions and the following disclaimers.
+//Redistributions in binary form must reproduce the above copyright notice,
+//this list of conditions and the following disclaimers in the documentation
+//and/or other materials provided with the distribution.
+//Neither the names of CM Labs or Vortex Studio
+//nor the names of its contributors may be used to endorse or promote products
+//derived from this Software without specific prior written permission.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH THE
+//SOFTWARE.
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "VortexInputCommandQueue.h"
+#include "VortexOutputSnapshot.h"
+
+class FRunnableThread;
+class FEvent;
+
+/// Dedicated thread that owns the Vortex application updates when the pipelined simulation mode is enabled.
+///
+/// The game thread hands a batch of steps to the thread with Kick() and joins with Wait().
+/// Between those two calls, the simulation thread is the only one allowed to call into the Vortex application.
+///
+class FVortexSimulationThread : public FRunnable
+{
+public:
+
+    FVortexSimulationThread();
+    virtual ~FVortexSimulationThread();
+
+    /// Starts updating the Vortex application StepCount times on the simulation thread.
+    /// The input command queues are drained right before each step, and the output snapshots are published right after it.
+    ///
+    /// @note Must be called from the game thread, and only when the thread is not busy (see Wait()).
+    ///
+    void Kick(int32 StepCount, TArray<FVortexInputCommandQueuePtr>&& InputCommandQueues, TArray<FVortexOutputSnapshotChannelPtr>&& OutputSnapshotChannels);
+
+    /// Blocks the calling thread until the steps handed with Kick() are completed.
+    /// Returns immediately if no step is in flight.
+    ///
+    void Wait();
+
+    /// Returns true if steps were handed to the simulation thread and were not joined yet with Wait().
+    ///
+    bool IsBusy() const { return bBusy; }
+
+    /// Returns the time, in seconds, spent running the steps of the last joined Kick(), when they completed (FPlatformTime::Seconds()), and how many steps were run.
+    ///
+    /// @note Only valid after Wait(), from the game thread.
+    ///
+    double GetLastStepsDuration() const { return LastStepsDuration; }
+    double GetLastStepsEndTime() const { return LastStepsEndTime; }
+    int32 GetLastStepCount() const { return LastStepCount; }
+
+    // FRunnable implementation
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+
+    FRunnableThread* Thread;
+    FEvent* KickEvent;
+    FEvent* DoneEvent;
+    TAtomic<bool> bStopping;
+    TAtomic<int32> PendingStepCount;
+
+    /// Written by the game thread before signaling KickEvent
+    TArray<FVortexInputCommandQueuePtr> InputQueues;
+    TArray<FVortexOutputSnapshotChannelPtr> SnapshotChannels;
+
+    /// Written by the simulation thread before signaling DoneEvent
+    double LastStepsDuration;
+    double LastStepsEndTime;
+    int32 LastStepCount;
+
+    /// Only read and written by the game thread
+    bool bBusy;
+};
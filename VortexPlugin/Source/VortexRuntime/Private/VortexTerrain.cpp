@@ -579,10 +579,7 @@ bool FVortexTerrain::ExportBody(UBodySetup* BodySetup, FBodyInstance* BodyInstan
                 ConvexBuffers.push_back({});
                 auto& data = ConvexBuffers.back();
                 data.resize(convex.VertexData.Num() * 3);
-                for (int32 k = 0; k < convex.VertexData.Num(); ++k)
-                {
-                    VortexIntegrationUtilities::ConvertTranslation(convex.VertexData[k] * Scale3D, &data[k * 3]);
-                }
+                VortexIntegrationUtilities::ConvertTranslations(convex.VertexData.GetData(), convex.VertexData.Num(), Scale3D, data.data());
                 shape.convex.vertices = data.data();
                 shape.convex.vertexCount = uint32_t(convex.VertexData.Num());
                 VortexIntegrationUtilities::ConvertTransform(ElemTM, shape.position, shape.rotation);
@@ -618,11 +615,10 @@ bool FVortexTerrain::ExportBody(UBodySetup* BodySetup, FBodyInstance* BodyInstan
                 const PxVec3* Vertices = TempTriMesh->getVertices();
                 const void* Triangles = TempTriMesh->getTriangles();
 
+                // PxVec3 and FVector are both 3 packed floats
+                static_assert(sizeof(PxVec3) == sizeof(FVector), "PxVec3 is converted as FVector");
                 NewTriangleMeshBuffer.Vertices.resize(VertexCount * 3);
-                for (uint32 k = 0; k < VertexCount; ++k)
-                {
-                    VortexIntegrationUtilities::ConvertTranslation(FVector(Vertices[k].x, Vertices[k].y, Vertices[k].z) * Scale3D, &NewTriangleMeshBuffer.Vertices[k*3]);
-                }
+                VortexIntegrationUtilities::ConvertTranslations(reinterpret_cast<const FVector*>(Vertices), int32(VertexCount), Scale3D, NewTriangleMeshBuffer.Vertices.data());
                 shape.triangleMesh.vertexCount = uint32_t(VertexCount);
                 shape.triangleMesh.vertices = NewTriangleMeshBuffer.Vertices.data();
                 VortexIntegrationUtilities::ConvertTransform(FTransform(), shape.position, shape.rotation);
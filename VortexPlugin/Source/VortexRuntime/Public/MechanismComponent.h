@@ -29,11 +29,18 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "ProceduralMeshComponent.h"
 #include "VortexIntegration/VortexIntegration.h"
+#include "VortexFieldHandle.h"
+#include "VortexInputCommandQueue.h"
+#include "VortexOutputSnapshot.h"
 #include "VortexMechanism.h"
+#include "VortexMechanismKey.h"
 #include "MechanismComponent.generated.h"
 
 DECLARE_STATS_GROUP(TEXT("VortexMechanism"), STATGROUP_VortexMechanism, STATCAT_Advanced);
 
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FVortexVHLOutputChanged, const FVortexFieldHandle&, Handle, const FVortexVHLValue&, Value);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMechanismLoaded, UMechanismComponent*, Component);
+
 USTRUCT(BlueprintType)
 struct FMechanismComponentMapping
 {
@@ -59,7 +66,149 @@ struct FMechanismComponentMappingSection
     TArray<FMechanismComponentMapping> Mappings;
 };
 
+// Transforms read from Vortex after a step, kept to interpolate between the last two steps
+struct FMechanismStepOutputs
+{
+    // Graphic node twins, in the order of GraphicNodeSceneComponentsTwins
+    TArray<FTransform> GraphicNodeTransforms;
+
+    // Component mappings, flattened in the order of ComponentMappings
+    TArray<FTransform> MappingTransforms;
+    TArray<bool> MappingValid;
+};
+
+// Latest node update notified for a twin, waiting for the next visual update of its component
+struct FMechanismPendingTwinUpdate
+{
+    FTransform Transform;
+    bool bVisible;
+    bool bPending;
+};
+
+// Component mapping resolved once, see UMechanismComponent::RebuildComponentMappings
+struct FMechanismCompiledComponentMapping
+{
+    // Interface and transform field names, kept in UTF-8
+    FVortexFieldHandle Handle;
+
+    // Null if the mapped component could not be found or is the root component, which is never moved
+    TWeakObjectPtr<USceneComponent> Component;
+
+    // False if the field did not exist when the mapping was compiled
+    bool bFieldValid;
+};
+
+// Scene component transforms of a component for one sync, gathered from Vortex, converted, then applied. See UMechanismComponent::SyncSceneComponents
+struct FMechanismSceneSync
+{
+    enum class ESource : uint8
+    {
+        // Not moved this time
+        None,
+        // Blend of the last two captured steps
+        Blend,
+        // Raw Vortex pose in TwinTranslations, TwinScales and TwinRotations, or VortexPoses
+        Vortex,
+    };
+
+    // Graphic node twins first, then the compiled component mappings
+    int32 TwinCount;
+    TArray<ESource> Sources;
+
+    // Raw Vortex poses of the twins, in separate arrays so runs of them are converted together
+    // 3 doubles per twin for the translation and the scale, 4 for the rotation quaternion, in Vortex conventions
+    TArray<double> TwinTranslations;
+    TArray<double> TwinScales;
+    TArray<double> TwinRotations;
+
+    // PoseStride doubles per mapping: translation, scale and rotation quaternion, in Vortex conventions
+    static constexpr int32 PoseStride = 10;
+    TArray<double> VortexPoses;
+
+    float Alpha;
+    TArray<FTransform> Transforms;
+};
+
+// VHL input value scheduled at a Vortex simulation time, see UMechanismComponent::QueueVHLFieldAs*
+struct FMechanismQueuedInput
+{
+    double SimulationTime;
+
+    // Bool and Integer inputs use IntegerValue, Float and Vector inputs use RealValue
+    int32 IntegerValue;
+    double RealValue[4];
+
+    // Set once the value has been sent to Vortex, the input is then only kept as the start of the next interpolation
+    bool bApplied;
+};
+
+// Queued values of a VHL input, sorted by simulation time
+struct FMechanismQueuedInputTrack
+{
+    FString VHLName;
+    FString FieldName;
+    VortexDataType DataType;
+    bool bInterpolate;
+    TArray<FMechanismQueuedInput> Inputs;
+};
+
+// Fields exchanged together with Vortex, see UMechanismComponent::CreateVHLBatch
+struct FMechanismVHLBatch
+{
+    TArray<FVortexFieldHandle> Inputs;
+    TArray<FVortexFieldHandle> Outputs;
+
+    // Input values waiting to be sent before the next step
+    FVortexVHLBatchValues InputValues;
+    bool bInputsPending;
+
+    // Output values gathered after the last step
+    FVortexVHLBatchValues OutputValues;
+};
+
+// Output watched for changes, see UMechanismComponent::SubscribeVHLOutputChanges
+struct FMechanismVHLOutputSubscription
+{
+    FVortexFieldHandle Handle;
+    float Epsilon;
+    FVortexVHLOutputChanged OnChanged;
+
+    // Single value read after the last steps, and last value reported to the delegate
+    FVortexVHLBatchValues Value;
+    FVortexVHLValue ReportedValue;
+    bool bReported;
+};
+
+class FBoolProperty;
+class FProperty;
+
+// Field of a USTRUCT bound to a VHL field of the same name, see UMechanismComponent::BindVHLStruct
+struct FMechanismVHLStructField
+{
+    FVortexFieldHandle Handle;
+
+    // Property locating the value in the struct, only used while the struct type is the bound one
+    const FProperty* Property;
+
+    // Only set for bool properties, which can be bitfields
+    const FBoolProperty* BoolProperty;
+
+    // Whether a real value is stored as double
+    bool bDouble;
+};
+
+// Property/type table of a USTRUCT mirroring a VHL interface
+struct FMechanismVHLStructBinding
+{
+    TWeakObjectPtr<const UScriptStruct> Struct;
+    TArray<FMechanismVHLStructField> Inputs;
+    TArray<FMechanismVHLStructField> Outputs;
+};
+
+class AVortexMechanismInstancer;
 class FVortexRuntimeModule;
+class UHierarchicalInstancedStaticMeshComponent;
+struct FVortexGraphicNodeUpdate;
 
 // Vortex mechanism component for unreal engine actors
 UCLASS( ClassGroup=(Vortex), meta=(BlueprintSpawnableComponent) )
@@ -75,6 +224,9 @@ protected:
     virtual void OnUnregister() override;
     virtual void OnRegister() override;
     virtual void PostRename(UObject* OldOuter, const FName OldName) override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(struct FPropertyChangedEvent& e) override;
+#endif
 
     // Called every frame
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -88,6 +240,32 @@ protected:
     // Called when this component has been unregistered from the FVortexRuntimeModule. It allows to do some internal cleanup.
     void onComponentUnregistered();
 
+    // Called by the FVortexRuntimeModule after a step when transform interpolation is enabled.
+    void CaptureStepOutputs();
+
+    // Moves the graphic node twins and mapped components to the Vortex state, from TickComponent().
+    // The centralized mechanism tick runs the three phases itself, converting the transforms of all the components in parallel.
+    void SyncSceneComponents(const FVortexRuntimeModule& RuntimeModule);
+
+    // Returns true if the scene components should be synchronized this frame, given the visual update interval set by the significance evaluation.
+    // Counts the frames skipped in between.
+    bool ConsumeVisualUpdate();
+
+    // Called by the FVortexRuntimeModule with the number of frames between visual updates, 0 to stop updating, see UVortexSettings::EnableSignificanceBasedUpdates.
+    void SetVisualUpdateInterval(int32 Interval);
+
+    // World bounds of the instances rendering the twins, invalid if none of them is instanced. The twins themselves are hidden and left behind.
+    FBox GetGraphicNodeInstanceBounds() const;
+
+    // Reads the Vortex poses, on the game thread since Vortex is not reentrant
+    void GatherSceneTransforms(const FVortexRuntimeModule& RuntimeModule);
+
+    // Converts and blends the gathered poses, without touching Vortex or the scene, so it can run on any thread
+    void ConvertSceneTransforms();
+
+    // Moves the scene components, on the game thread
+    void ApplySceneTransforms();
+
 public:    
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vortex")
@@ -97,6 +275,29 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
     TArray<FMechanismComponentMappingSection> ComponentMappings;
 
+    // Render the static mesh graphic node twins as instances shared with the other mechanisms using the same meshes and materials,
+    // see AVortexMechanismInstancer. Read at BeginPlay. The twins themselves are hidden and stop moving, so nothing should be attached to them.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vortex")
+    bool bUseInstancedRendering;
+
+    // Broadcast once the component has begun play with its Vortex Mechanism loaded. With asynchronous mechanism loading, this can be a few
+    // frames after BeginPlay, see UVortexSettings::EnableAsynchronousMechanismLoading. The VHL inputs set in between are applied right before.
+    UPROPERTY(BlueprintAssignable, Category = "Vortex")
+    FMechanismLoaded OnMechanismLoaded;
+
+    // True from BeginPlay until the Vortex Mechanism is loaded, when it is loaded asynchronously. VHL outputs cannot be read in the meantime.
+    UFUNCTION(BlueprintPure, Category = "Vortex")
+    bool IsMechanismLoadPending() const { return bMechanismLoadPending; }
+
+    // Defer a command calling into the Vortex Mechanism until it is loaded.
+    // Returns false if the mechanism is not pending, in which case the command was not queued and the caller can execute it right away.
+    bool DeferUntilMechanismLoaded(TFunction<void()>&& Command);
+
+    // Resolve ComponentMappings again. The mappings are resolved once and only rebuilt when their number changes,
+    // call this after changing a mapped component or field name at runtime.
+    UFUNCTION(BlueprintCallable, Category = "Vortex|Component Mapping")
+    void RebuildComponentMappings();
+
     // Get/Set for Boolean
     UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|get")
     void GetVHLFieldAsBool(FString VHLName, FString FieldName, bool& Value);
@@ -186,17 +387,268 @@ public:
         UTexture2D*& NormalColor0, UTexture2D*& NormalColor1, UTexture2D*& NormalColor2,
         UTexture2D*& HeightMapColor0, UTexture2D*& HeightMapColor1, UTexture2D*& HeightMapColor2);
 
+    // Resolve a VHL field once, to access it afterwards with the Get/SetVHLFieldHandleAs* functions without any name conversion or validation.
+    // The handle is invalidated when the component is unregistered, e.g. when its Vortex Mechanism changes.
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    FVortexFieldHandle ResolveVHLField(FString VHLName, FString FieldName, EVortexVHLFieldType FieldType, EVortexVHLDataType DataType, bool& bOK);
+
+    UFUNCTION(BlueprintPure, Category = "Vortex|VHL|handle")
+    bool IsVHLFieldHandleValid(const FVortexFieldHandle& Handle) const;
+
+    // Get/Set for Boolean handles
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void GetVHLFieldHandleAsBool(const FVortexFieldHandle& Handle, bool& Value);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void SetVHLFieldHandleAsBool(const FVortexFieldHandle& Handle, bool Value);
+
+    // Get/Set for Integer handles
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void GetVHLFieldHandleAsInteger(const FVortexFieldHandle& Handle, int32& Value);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void SetVHLFieldHandleAsInteger(const FVortexFieldHandle& Handle, int32 Value);
+
+    // Get/Set for Float handles
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void GetVHLFieldHandleAsFloat(const FVortexFieldHandle& Handle, float& Value);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void SetVHLFieldHandleAsFloat(const FVortexFieldHandle& Handle, float Value);
+
+    // Get/Set for Vector2 handles
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void GetVHLFieldHandleAsVector2(const FVortexFieldHandle& Handle, FVector2D& Value);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void SetVHLFieldHandleAsVector2(const FVortexFieldHandle& Handle, FVector2D Value);
+
+    // Get/Set for Vector3 handles
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void GetVHLFieldHandleAsVector3(const FVortexFieldHandle& Handle, FVector& Value);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void SetVHLFieldHandleAsVector3(const FVortexFieldHandle& Handle, FVector Value);
+
+    // Get/Set for Vector4 handles
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void GetVHLFieldHandleAsVector4(const FVortexFieldHandle& Handle, FVector4& Value);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void SetVHLFieldHandleAsVector4(const FVortexFieldHandle& Handle, FVector4 Value);
+
+    // Get/Set for Transform handles
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void GetVHLFieldHandleAsTransform(const FVortexFieldHandle& Handle, FTransform& Transform);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|handle")
+    void SetVHLFieldHandleAsTransform(const FVortexFieldHandle& Handle, FTransform Transform);
+
+    // Register a set of resolved input fields and output fields exchanged together with Vortex.
+    // Their values are then passed as contiguous arrays per data type, in the order of the given fields.
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|batch")
+    int32 CreateVHLBatch(const TArray<FVortexFieldHandle>& Inputs, const TArray<FVortexFieldHandle>& Outputs, bool& bOK);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|batch")
+    void DestroyVHLBatch(int32 BatchId);
+
+    // Set the values of all the batch inputs, sent to Vortex right before the next step
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|batch")
+    void SetVHLBatchInputs(int32 BatchId, const FVortexVHLBatchValues& Values);
+
+    // Get the values of all the batch outputs, gathered right after the last step
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|batch")
+    void GetVHLBatchOutputs(int32 BatchId, FVortexVHLBatchValues& Values);
+
+    // Bind a USTRUCT mirroring a VHL interface, each bool, int32, float, FVector2D, FVector, FVector4 and FTransform property being
+    // bound to the input or output field of the same name. Fields are validated once here, the struct is then exchanged in a single call.
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|struct")
+    int32 BindVHLStruct(FString VHLName, const UScriptStruct* StructType, bool& bOK);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|struct")
+    void UnbindVHLStruct(int32 BindingId);
+
+    // Set all the input fields of a bound struct
+    UFUNCTION(BlueprintCallable, CustomThunk, Category = "Vortex|VHL|struct", meta = (CustomStructureParam = "Value"))
+    void SetVHLStruct(int32 BindingId, const int32& Value);
+    DECLARE_FUNCTION(execSetVHLStruct);
+
+    // Get all the output fields of a bound struct
+    UFUNCTION(BlueprintCallable, CustomThunk, Category = "Vortex|VHL|struct", meta = (CustomStructureParam = "Value"))
+    void GetVHLStruct(int32 BindingId, int32& Value);
+    DECLARE_FUNCTION(execGetVHLStruct);
+
+    // C++ versions of the struct binding functions
+    template <typename StructType>
+    int32 BindVHLStructType(const FString& VHLName, bool& bOK) { return BindVHLStruct(VHLName, StructType::StaticStruct(), bOK); }
+
+    template <typename StructType>
+    void SetVHLStructValue(int32 BindingId, const StructType& Value) { SetVHLStructData(BindingId, StructType::StaticStruct(), &Value); }
+
+    template <typename StructType>
+    void GetVHLStructValue(int32 BindingId, StructType& Value) { GetVHLStructData(BindingId, StructType::StaticStruct(), &Value); }
+
+    void SetVHLStructData(int32 BindingId, const UScriptStruct* StructType, const void* Data);
+    void GetVHLStructData(int32 BindingId, const UScriptStruct* StructType, void* Data);
+
+    // Call OnChanged with the value of an output field handle whenever it changes by more than Epsilon, and once with its first value.
+    // Vectors change when any of their components does, transforms when their translation or rotation does. Booleans and integers ignore Epsilon.
+    // Outputs are compared once per frame, after the steps of the frame. Returns the subscription id, or -1 on failure.
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|subscription")
+    int32 SubscribeVHLOutputChanges(const FVortexFieldHandle& Handle, float Epsilon, const FVortexVHLOutputChanged& OnChanged, bool& bOK);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|subscription")
+    void UnsubscribeVHLOutputChanges(int32 SubscriptionId);
+
+    // Get the queue other threads can push VHL input commands into, drained right before each step.
+    // Must be called from the game thread. The queue is unbound when the component is unregistered.
+    FVortexInputCommandQueuePtr GetInputCommandQueue();
+
+    // Subscribe to snapshots of output fields, and optionally of the graphic node transforms, published right after each step.
+    // Must be called from the game thread, the returned channel can then be read from any one thread without locking.
+    // Releasing the channel ends the subscription. Returns nullptr if a handle is not a valid output field handle.
+    FVortexOutputSnapshotChannelPtr SubscribeOutputSnapshots(const TArray<FVortexFieldHandle>& Outputs, bool bIncludeGraphicNodes);
+
+    // Queue VHL inputs applied before the first Vortex step starting at or after SimulationTime, in simulation seconds.
+    // With bInterpolate, each step in between two queued values receives a linear interpolation of them.
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|queue")
+    void QueueVHLFieldAsBool(FString VHLName, FString FieldName, bool Value, float SimulationTime);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|queue")
+    void QueueVHLFieldAsInteger(FString VHLName, FString FieldName, int32 Value, float SimulationTime);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|queue")
+    void QueueVHLFieldAsFloat(FString VHLName, FString FieldName, float Value, float SimulationTime, bool bInterpolate);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|queue")
+    void QueueVHLFieldAsVector2(FString VHLName, FString FieldName, FVector2D Value, float SimulationTime, bool bInterpolate);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|queue")
+    void QueueVHLFieldAsVector3(FString VHLName, FString FieldName, FVector Value, float SimulationTime, bool bInterpolate);
+
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|queue")
+    void QueueVHLFieldAsVector4(FString VHLName, FString FieldName, FVector4 Value, float SimulationTime, bool bInterpolate);
+
+    // Discard all the queued VHL inputs that were not applied yet
+    UFUNCTION(BlueprintCallable, Category = "Vortex|VHL|queue")
+    void ClearVHLInputQueue();
+
 private:
     friend class FVortexRuntimeModule;
 
+    void QueueVHLInput(const FString& FunctionName, const FString& VHLName, const FString& FieldName, VortexDataType DataType, bool bInterpolate, const FMechanismQueuedInput& Input);
+
+    // Called by the FVortexRuntimeModule before each step, with the simulation time at the start of the step.
+    void ApplyQueuedVHLInputs(double SimulationTime);
+    bool HasQueuedVHLInputs() const;
+
+    // Called by the FVortexRuntimeModule right before the steps of a frame, and right after them.
+    void FlushVHLBatchInputs();
+    void GatherVHLBatchOutputs();
+
+    // Called by the FVortexRuntimeModule on the game thread, once the steps of a frame are done.
+    void DispatchVHLOutputChanges();
+
+    bool PreValidateVHLFieldHandle(const TCHAR* FunctionName, const FVortexFieldHandle& Handle, EVortexVHLFieldType FieldType, EVortexVHLDataType DataType);
+    void LogErrorForVHLFieldHandle(const TCHAR* FunctionName, const FVortexFieldHandle& Handle);
+
     bool PreValidateVHLFunction(const FString& FunctionName, const FString& FilePath, const FString& VHLName, const FString& FieldName);
     void LogErrorForVHLFunction(const FString& FunctionName, const FString& FilePath, VortexObjectHandle objectHandle, const FString& VHLName, const FString& FieldName, VortexFieldType fieldType, VortexDataType dataType);
 
-    FString LoadedMechanismKey;
+    FMechanismKey LoadedMechanismKey;
     VortexObjectHandle VortexObject;
 
+    // Set by the FVortexRuntimeModule while the mechanism is waiting to be loaded, with the VHL calls to apply once it is
+    bool bMechanismLoadPending;
+    TArray<TFunction<void()>> MechanismLoadCommands;
+
+    // Called from BeginPlay once the mechanism is loaded, by the FVortexRuntimeModule when it was loaded asynchronously
+    void OnMechanismLoadCompleted();
+
+    // Fills GraphicNodeObjectHandles and GraphicNodeSceneComponentsTwins with the connected graphic nodes having a twin in the owner
+    void FindGraphicNodeTwins(TArray<FString>& TwinNodeNames);
+
+    // Loads the mechanism of an editor component, from OnRegister or by the FVortexRuntimeModule when it was deferred, see UVortexSettings::EnableLazyEditorMechanismLoading
+    void LoadEditorMechanism();
+
+    // Last owner transform sent to the mechanism of an editor component
+    FTransform LastEditorWorldTransform;
+
     TArray<VortexObjectHandle> GraphicNodeObjectHandles;
     TArray<USceneComponent*> GraphicNodeSceneComponentsTwins;
+
+    // Twins moved by the node updates Vortex notifies, once they were synchronized a first time, see UVortexSettings::EnableGraphicNodeNotifications
+    TArray<bool> GraphicNodeTwinsPushed;
+    bool bGraphicNodeTwinsSynced;
+
+    // Scale of each twin at its last polled sync. Notifications only carry the local scale of a node, while the polled parent transform scale is applied as world scale
+    TArray<FVector> GraphicNodeTwinScales;
+
+    // Called by the FVortexRuntimeModule with the latest notified state of the node of a twin.
+    // Applied right away when the component is updated every frame, otherwise kept until its next visual update.
+    void ApplyGraphicNodeUpdate(int32 TwinIndex, const FVortexGraphicNodeUpdate& Update);
+
+    TArray<FMechanismPendingTwinUpdate> PendingTwinUpdates;
+    void MoveNotifiedGraphicNodeTwin(int32 TwinIndex, const FTransform& Transform, bool bVisible);
+    void ApplyPendingTwinUpdates();
+
+    // Instances rendering the twins when bUseInstancedRendering is set, in the order of GraphicNodeSceneComponentsTwins, null for the twins that are not instanced
+    TArray<UHierarchicalInstancedStaticMeshComponent*> GraphicNodeInstanceComponents;
+    TArray<int32> GraphicNodeInstanceIndices;
+    TWeakObjectPtr<AVortexMechanismInstancer> Instancer;
+
+    void AddGraphicNodeInstances();
+    void RemoveGraphicNodeInstances();
+
+    // Moves a twin, or its instance, unless it is already at that transform
+    bool MoveGraphicNodeTwin(int32 TwinIndex, const FTransform& Transform);
+
+    // Called by the AVortexMechanismInstancer when removing another instance moved the instance of a twin
+    friend class AVortexMechanismInstancer;
+    void OnGraphicNodeInstanceMoved(int32 TwinIndex, int32 Index);
+
+    // ComponentMappings flattened, with resolved fields and components
+    TArray<FMechanismCompiledComponentMapping> CompiledMappings;
+    uint32 CompiledMappingsGeneration;
+    bool bComponentMappingsDirty;
+
+    // Rebuilds the compiled mappings if they are stale, returns false if they cannot be compiled yet
+    bool EnsureComponentMappingsCompiled();
+
+    // Reads the transforms of all the compiled mappings, in one pass
+    void FetchComponentMappingTransforms(FMechanismStepOutputs& Outputs) const;
+
+    // Kept between syncs to avoid reallocating
+    FMechanismSceneSync SceneSync;
+
+    // Frames between scene component syncs, set from the significance of the mechanism, and frames left until the next one
+    int32 VisualUpdateInterval;
+    int32 FramesUntilVisualUpdate;
+
+    // Outputs of the last two captured steps, StepOutputs[CurrentStepOutputs] being the most recent
+    FMechanismStepOutputs StepOutputs[2];
+    int32 CurrentStepOutputs;
+    int32 CapturedStepCount;
+
+    TArray<FMechanismQueuedInputTrack> QueuedInputTracks;
+
+    // Incremented when the component is unregistered, to invalidate the resolved field handles
+    uint32 FieldHandleGeneration;
+
+    TMap<int32, FMechanismVHLBatch> VHLBatches;
+    int32 NextVHLBatchId;
+
+    FVortexInputCommandQueuePtr InputCommandQueue;
+
+    TArray<FVortexOutputSnapshotChannelPtr> OutputSnapshotChannels;
+
+    TMap<int32, FMechanismVHLOutputSubscription> VHLOutputSubscriptions;
+    int32 NextVHLOutputSubscriptionId;
+
+    TMap<int32, FMechanismVHLStructBinding> VHLStructBindings;
+    int32 NextVHLStructBindingId;
+
+    const FMechanismVHLStructBinding* FindVHLStructBinding(const TCHAR* FunctionName, int32 BindingId, const UScriptStruct* StructType) const;
 };
 
 UCLASS()
@@ -37,9 +37,25 @@ class VORTEXRUNTIME_API UVortexApplicationBlueprintLib : public UBlueprintFuncti
     GENERATED_BODY()
     
 public:
+    /// Starts the Vortex simulation.
+    /// With asynchronous mechanism loading, the simulation starts once the pending mechanisms are loaded.
+    ///
+    /// @param TargetSpeedMultiplier  Simulated time per wall clock time, e.g. 2 runs the simulation twice as fast as real time when the step budget allows it.
+    ///                               Ignored in batch mode, where the speed only depends on the cost of the steps.
+    ///
     UFUNCTION(BlueprintCallable, Category = "Vortex|Application", meta = (WorldContext = "WorldContextObject"))
-    static void StartSimulation(UObject* WorldContextObject);
+    static void StartSimulation(UObject* WorldContextObject, float TargetSpeedMultiplier = 1.0f);
 
     UFUNCTION(BlueprintCallable, Category = "Vortex|Application", meta = (WorldContext = "WorldContextObject"))
     static void StopSimulation(UObject* WorldContextObject);
+
+    /// Returns the ratio of simulated time over wall clock time achieved recently, averaged over a few frames.
+    ///
+    UFUNCTION(BlueprintPure, Category = "Vortex|Application")
+    static float GetRealTimeFactor();
+
+    /// Returns the current Vortex simulation time, in seconds. Use it to timestamp queued VHL inputs.
+    ///
+    UFUNCTION(BlueprintPure, Category = "Vortex|Application")
+    static float GetSimulationTime();
 };
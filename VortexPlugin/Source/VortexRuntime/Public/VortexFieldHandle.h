@@ -0,0 +1,180 @@
+#pragma once
+//Copyright(c) 2019 CM Labs Simulations Inc. All rights reserved.
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of
+//the sample code software and associated documentation files (the "Software"), to deal with
+//the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies
+//of the Software, and to permit persons to whom the Software is furnished to
+//do so, subject to the following conditions :
+//
+//Redistributions of source code must retain the above copyright notice,
+//this list of conditions and the following disclaimers.
+//Redistributions in binary form must reproduce the above copyright notice,
+//this list of conditions and the following disclaimers in the documentation
+//and/or other materials provided with the distribution.
+//Neither the names of CM Labs or Vortex Studio
+//nor the names of its contributors may be used to endorse or promote products
+//derived from this Software without specific prior written permission.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH THE
+//SOFTWARE.
+#include "CoreMinimal.h"
+#include "VortexIntegration/VortexIntegration.h"
+#include "VortexFieldHandle.generated.h"
+
+/// Kind of VHL field a FVortexFieldHandle refers to
+UENUM(BlueprintType)
+enum class EVortexVHLFieldType : uint8
+{
+    Input,
+    Output,
+};
+
+/// Data type of the VHL field a FVortexFieldHandle refers to
+UENUM(BlueprintType)
+enum class EVortexVHLDataType : uint8
+{
+    Boolean,
+    Integer,
+    Float,
+    Vector2,
+    Vector3,
+    Vector4,
+    Transform,
+};
+
+struct FVortexVHLBatchValues;
+
+///
+/// A VHL field resolved once with UMechanismComponent::ResolveVHLField().
+/// The interface and field names are kept in UTF-8 and the field is validated at resolution, so the typed accessors
+/// UMechanismComponent::GetVHLFieldHandleAs* and SetVHLFieldHandleAs* go straight to Vortex.
+/// A handle is invalidated when its mechanism component is unregistered from the runtime module, it must then be resolved again.
+///
+USTRUCT(BlueprintType)
+struct VORTEXRUNTIME_API FVortexFieldHandle
+{
+    GENERATED_BODY()
+
+    FVortexFieldHandle();
+
+    /// Interface name, as a null-terminated UTF-8 string
+    const char* GetInterfaceName() const { return InterfaceName.GetData(); }
+
+    /// Field name, as a null-terminated UTF-8 string
+    const char* GetFieldName() const { return FieldName.GetData(); }
+
+    /// Sends the value at Index, in the array of the handle data type, to this input field.
+    ///
+    /// @return False if Vortex could not set the field
+    ///
+    bool WriteInput(const FVortexVHLBatchValues& Values, int32 Index) const;
+
+    /// Reads this output field into the value at Index, in the array of the handle data type. The value is left untouched on failure.
+    ///
+    /// @return False if Vortex could not get the field
+    ///
+    bool ReadOutput(FVortexVHLBatchValues& Values, int32 Index) const;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Vortex")
+    EVortexVHLFieldType FieldType;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Vortex")
+    EVortexVHLDataType DataType;
+
+private:
+    friend class UMechanismComponent;
+    friend class FVortexInputCommandQueue;
+
+    TArray<ANSICHAR> InterfaceName;
+    TArray<ANSICHAR> FieldName;
+
+    /// Vortex object and component generation the handle was resolved against
+    VortexObjectHandle VortexObject;
+    uint32 Generation;
+};
+
+///
+/// Values exchanged in one call with UMechanismComponent::SetVHLBatchInputs() and GetVHLBatchOutputs().
+/// Each array holds the values of the batch fields of its data type, in the order the fields were given to UMechanismComponent::CreateVHLBatch().
+///
+USTRUCT(BlueprintType)
+struct VORTEXRUNTIME_API FVortexVHLBatchValues
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    TArray<bool> Booleans;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    TArray<int32> Integers;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    TArray<float> Floats;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    TArray<FVector2D> Vectors2;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    TArray<FVector> Vectors3;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    TArray<FVector4> Vectors4;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    TArray<FTransform> Transforms;
+
+    /// Sizes the arrays to hold the values of the given fields
+    void Allocate(const TArray<FVortexFieldHandle>& Fields);
+
+    /// Returns true if both hold the same number of values of each data type
+    bool HasSameLayout(const FVortexVHLBatchValues& Other) const;
+};
+
+///
+/// Value of a single VHL field, reported by the UMechanismComponent::SubscribeVHLOutputChanges() delegates.
+/// Only the member matching the data type of the field handle is meaningful.
+///
+USTRUCT(BlueprintType)
+struct VORTEXRUNTIME_API FVortexVHLValue
+{
+    GENERATED_BODY()
+
+    FVortexVHLValue();
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    bool Boolean;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    int32 Integer;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    float Float;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    FVector2D Vector2;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    FVector Vector3;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    FVector4 Vector4;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
+    FTransform Transform;
+};
+
+namespace VortexFieldHandle
+{
+    /// Returns the Vortex data type corresponding to a VHL data type
+    VORTEXRUNTIME_API VortexDataType ToVortexDataType(EVortexVHLDataType DataType);
+
+    /// Returns the Vortex field type corresponding to a VHL field type
+    VORTEXRUNTIME_API VortexFieldType ToVortexFieldType(EVortexVHLFieldType FieldType);
+}
@@ -0,0 +1,105 @@
+#pragma once
+//Copyright(c) 2019 CM Labs Simulations Inc. All rights reserved.
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of
+//the sample code software and associated documentation files (the "Software"), to deal with
+//the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies
+//of the Software, and to permit persons to whom the Software is furnished to
+//do so, subject to the following conditions :
+//
+//Redistributions of source code must retain the above copyright notice,
+//this list of conditions and the following disclaimers.
+//Redistributions in binary form must reproduce the above copyright notice,
+//this list of conditions and the following disclaimers in the documentation
+//and/or other materials provided with the distribution.
+//Neither the names of CM Labs or Vortex Studio
+//nor the names of its contributors may be used to endorse or promote products
+//derived from this Software without specific prior written permission.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH THE
+//SOFTWARE.
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "VortexFieldHandle.h"
+
+/// A typed VHL input value, pushed to a FVortexInputCommandQueue
+struct FVortexInputCommand
+{
+    FVortexFieldHandle Handle;
+
+    /// Boolean and Integer values use IntegerValue, Float and Vector values use RealValue, Transform values use Transform
+    int32 IntegerValue;
+    double RealValue[4];
+    FTransform Transform;
+};
+
+///
+/// Lock-free queue of VHL input commands of a mechanism component, which any thread can push into.
+/// The commands are sent to Vortex right before the next step, by the thread running the steps.
+///
+/// The queue is obtained from UMechanismComponent::GetInputCommandQueue() on the game thread, with field handles resolved with
+/// UMechanismComponent::ResolveVHLField(). Both can then be used from any thread. The queue is unbound when the component is
+/// unregistered, pushing then fails and the caller must get a new queue. Only the handles resolved by the same component,
+/// since it last loaded its mechanism, are accepted.
+///
+class VORTEXRUNTIME_API FVortexInputCommandQueue
+{
+public:
+
+    /// @param InVortexObject  Mechanism of the component owning the queue
+    /// @param InGeneration    Field handle generation of the component owning the queue
+    ///
+    FVortexInputCommandQueue(VortexObjectHandle InVortexObject, uint32 InGeneration);
+
+    /// Push an input value, applied before the next step.
+    ///
+    /// @return False if the queue is unbound, or if the handle is not an input of that data type resolved by the owner of the queue
+    ///
+    bool Push(const FVortexFieldHandle& Handle, bool Value);
+    bool Push(const FVortexFieldHandle& Handle, int32 Value);
+    bool Push(const FVortexFieldHandle& Handle, double Value);
+    bool Push(const FVortexFieldHandle& Handle, const FVector2D& Value);
+    bool Push(const FVortexFieldHandle& Handle, const FVector& Value);
+    bool Push(const FVortexFieldHandle& Handle, const FVector4& Value);
+    bool Push(const FVortexFieldHandle& Handle, const FTransform& Value);
+
+    /// Returns false once the mechanism component owning the queue was unregistered
+    ///
+    bool IsBound() const { return bBound; }
+
+    /// Returns true if the handle was resolved by the mechanism component owning the queue, since it last loaded its mechanism
+    ///
+    bool Accepts(const FVortexFieldHandle& Handle) const;
+
+private:
+    friend class UMechanismComponent;
+    friend class FVortexRuntimeModule;
+    friend class FVortexSimulationThread;
+
+    bool Push(FVortexInputCommand&& Command, EVortexVHLDataType DataType);
+
+    /// Sends all the queued commands to Vortex, in push order.
+    ///
+    /// @note Single consumer: only called by the thread running the steps.
+    ///
+    void Drain();
+
+    /// Drops the queued commands and refuses new ones.
+    ///
+    void Unbind();
+
+    TQueue<FVortexInputCommand, EQueueMode::Mpsc> Commands;
+    TAtomic<bool> bBound;
+
+    /// Vortex object and field handle generation of the owner when the queue was created
+    const VortexObjectHandle VortexObject;
+    const uint32 Generation;
+};
+
+using FVortexInputCommandQueuePtr = TSharedPtr<FVortexInputCommandQueue, ESPMode::ThreadSafe>;
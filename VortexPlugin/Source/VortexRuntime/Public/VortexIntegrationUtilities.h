@@ -151,4 +151,47 @@ namespace VortexIntegrationUtilities
     /// @return The equivalent rotation in the Unreal world.
     ///
     VORTEXRUNTIME_API FQuat ConvertRotation(const double rotationQuaternion[4]);
+
+    /// Array variants of the conversions above, for the bulk paths (graphics meshes, particles, collision geometry, point clouds, graphic nodes).
+    /// Inputs are arrays of structures: 3 coordinates (x, y, z) per translation, direction or scale, and 4 (w, x, y, z) per rotation.
+    /// Vectors are converted 4 at a time using SIMD instructions when the platform supports them, the remainder one at a time.
+    /// Rotations are converted one per SIMD instruction, a quaternion fills a register.
+    /// Results match the single element conversions up to float rounding.
+
+    /// Converts Count translations from the Vortex world to the Unreal world, see ConvertTranslation().
+    ///
+    /// @param[in]  translations Count translations in the Vortex world (x, y, z).
+    /// @param[in]  count        The number of translations.
+    /// @param[out] out          Count translations in the Unreal world.
+    ///
+    VORTEXRUNTIME_API void ConvertTranslations(const float* translations, int32 count, FVector* out);
+    VORTEXRUNTIME_API void ConvertTranslations(const double* translations, int32 count, FVector* out);
+
+    /// Scales Count vectors of the Unreal world, then converts them to translations in the Vortex world, see ConvertTranslation().
+    ///
+    /// @param[in]  unrealVectors Count vectors in the Unreal world.
+    /// @param[in]  count         The number of vectors.
+    /// @param[in]  scale         The scale applied to every vector, in the Unreal world.
+    /// @param[out] translations  Count translations in the Vortex world (x, y, z).
+    ///
+    VORTEXRUNTIME_API void ConvertTranslations(const FVector* unrealVectors, int32 count, const FVector& scale, double* translations);
+
+    /// Converts Count direction vectors from the Vortex world to the Unreal world, see ConvertDirection().
+    ///
+    VORTEXRUNTIME_API void ConvertDirections(const float* directions, int32 count, FVector* out);
+    VORTEXRUNTIME_API void ConvertDirections(const double* directions, int32 count, FVector* out);
+
+    /// Converts Count rotations as quaternions from the Vortex world to the Unreal world, see ConvertRotation().
+    ///
+    VORTEXRUNTIME_API void ConvertRotations(const double* rotationQuaternions, int32 count, FQuat* out);
+
+    /// Converts Count graphic node transforms, as read by VortexGetParentTransform(), from the Vortex world to the Unreal world.
+    ///
+    /// @param[in]  translations        Count translations in the Vortex world (x, y, z).
+    /// @param[in]  scales              Count scales (x, y, z), used as is.
+    /// @param[in]  rotationQuaternions Count rotations in the Vortex world (w, x, y, z).
+    /// @param[in]  count               The number of transforms.
+    /// @param[out] out                 Count transforms in the Unreal world.
+    ///
+    VORTEXRUNTIME_API void ConvertTransforms(const double* translations, const double* scales, const double* rotationQuaternions, int32 count, FTransform* out);
 }
@@ -86,4 +86,13 @@ public:
     // Mapping for Vortex Graphic Nodes
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vortex")
     TArray<FMechanismGraphicNodeMapping> GraphicNodeMappings;
+
+    // MechanismFilepath as a name, so mechanism keys are built without hashing the path
+    FName GetMechanismFilepathName() const { return MechanismFilepathName; }
+
+    // To call after setting MechanismFilepath from code, loading and editing the asset already do
+    void UpdateMechanismFilepathName();
+
+private:
+    FName MechanismFilepathName;
 };
@@ -0,0 +1,126 @@
+#pragma once
+//Copyright(c) 2019 CM Labs Simulations Inc. All rights reserved.
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of
+//the sample code software and associated documentation files (the "Software"), to deal with
+//the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies
+//of the Software, and to permit persons to whom the Software is furnished to
+//do so, subject to the following conditions :
+//
+//Redistributions of source code must retain the above copyright notice,
+//this list of conditions and the following disclaimers.
+//Redistributions in binary form must reproduce the above copyright notice,
+//this list of conditions and the following disclaimers in the documentation
+//and/or other materials provided with the distribution.
+//Neither the names of CM Labs or Vortex Studio
+//nor the names of its contributors may be used to endorse or promote products
+//derived from this Software without specific prior written permission.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH THE
+//SOFTWARE.
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "VortexMechanismInstancer.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UMechanismComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/// Mesh and materials shared by the instances of an instanced static mesh component
+struct FVortexInstancedMeshKey
+{
+    UStaticMesh* Mesh;
+    TArray<UMaterialInterface*> Materials;
+
+    bool operator==(const FVortexInstancedMeshKey& Other) const { return Mesh == Other.Mesh && Materials == Other.Materials; }
+
+    friend uint32 GetTypeHash(const FVortexInstancedMeshKey& Key)
+    {
+        uint32 Hash = GetTypeHash(Key.Mesh);
+        for (const UMaterialInterface* Material : Key.Materials)
+        {
+            Hash = HashCombine(Hash, GetTypeHash(Material));
+        }
+        return Hash;
+    }
+};
+
+///
+/// Renders the graphic node twins of the mechanism components using instanced rendering (see UMechanismComponent::bUseInstancedRendering)
+/// through one hierarchical instanced static mesh component per unique mesh and materials. One instancer is spawned per world, on demand.
+///
+/// Instance transforms are written in bulk: mechanism components set them in a CPU side copy during their sync, and the instancer
+/// sends the modified ones to the instanced components once per frame, at the end of the frame or when the centralized mechanism tick is done.
+///
+UCLASS(NotPlaceable, Transient)
+class VORTEXRUNTIME_API AVortexMechanismInstancer : public AActor
+{
+    GENERATED_BODY()
+public:
+    AVortexMechanismInstancer();
+
+    /// Returns the instancer of the world, or nullptr if no mechanism uses instanced rendering
+    ///
+    static AVortexMechanismInstancer* Find(UWorld* World);
+
+    /// Returns the instancer of the world, spawning it if needed
+    ///
+    static AVortexMechanismInstancer* Get(UWorld* World);
+
+    /// Returns true if the twin can be rendered as an instance: a static mesh component without attached children
+    ///
+    static bool CanInstance(const UStaticMeshComponent* Twin);
+
+    /// Adds an instance of the mesh and materials of the twin, at the transform of the twin.
+    ///
+    /// @param Owner       Component notified through UMechanismComponent::OnGraphicNodeInstanceMoved() when removing another instance moves this one
+    /// @param TwinIndex   Index of the twin in the owner
+    /// @param[out] Index  Index of the instance in the returned component
+    ///
+    UHierarchicalInstancedStaticMeshComponent* AddInstance(UStaticMeshComponent* Twin, UMechanismComponent* Owner, int32 TwinIndex, int32& Index);
+
+    void RemoveInstance(UHierarchicalInstancedStaticMeshComponent* Component, int32 Index);
+
+    /// Sets the world transform of an instance, sent to the render state with the next Flush().
+    ///
+    /// @return False if the instance already was at that transform
+    ///
+    bool SetInstanceTransform(UHierarchicalInstancedStaticMeshComponent* Component, int32 Index, const FTransform& Transform, float Tolerance);
+
+    /// Sends the modified instance transforms to their instanced components
+    ///
+    void Flush();
+
+    virtual void Tick(float DeltaSeconds) override;
+
+private:
+
+    struct FInstancedMesh
+    {
+        UHierarchicalInstancedStaticMeshComponent* Component;
+
+        /// World transform and owner twin of each instance
+        TArray<FTransform> Transforms;
+        TArray<TPair<TWeakObjectPtr<UMechanismComponent>, int32>> Owners;
+
+        /// Range of instances modified since the last flush
+        int32 DirtyStart;
+        int32 DirtyEnd;
+    };
+
+    FInstancedMesh* FindInstancedMesh(UHierarchicalInstancedStaticMeshComponent* Component);
+
+    TMap<FVortexInstancedMeshKey, FInstancedMesh> InstancedMeshes;
+
+    /// Dirty range of a flushed component, kept to reuse its allocation
+    TArray<FTransform> FlushTransforms;
+};
@@ -0,0 +1,66 @@
+#pragma once
+//Copyright(c) 2019 CM Labs Simulations Inc. All rights reserved.
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of
+//the sample code software and associated documentation files (the "Software"), to deal with
+//the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies
+//of the Software, and to permit persons to whom the Software is furnished to
+//do so, subject to the following conditions :
+//
+//Redistributions of source code must retain the above copyright notice,
+//this list of conditions and the following disclaimers.
+//Redistributions in binary form must reproduce the above copyright notice,
+//this list of conditions and the following disclaimers in the documentation
+//and/or other materials provided with the distribution.
+//Neither the names of CM Labs or Vortex Studio
+//nor the names of its contributors may be used to endorse or promote products
+//derived from this Software without specific prior written permission.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH THE
+//SOFTWARE.
+
+#include "CoreMinimal.h"
+
+class UMechanismComponent;
+
+/// Identifies the Vortex mechanism shared by mechanism components.
+/// Unreal holds multiple components at the same time to represent the same piece of data in different contexts,
+/// dragging an object in the 3D view or editing Blueprints each have their own component instance, and they all share the same Vortex Mechanism.
+struct VORTEXRUNTIME_API FMechanismKey
+{
+    FMechanismKey();
+
+    /// Key of the mechanism asset of a component in its world, invalid when the component has no world, owner or mechanism asset
+    explicit FMechanismKey(const UMechanismComponent* Component);
+
+    bool IsValid() const
+    {
+        return !Component.IsNone();
+    }
+
+    bool operator==(const FMechanismKey& Other) const
+    {
+        return Component == Other.Component && Actor == Other.Actor && World == Other.World && MechanismFilepath == Other.MechanismFilepath;
+    }
+
+    bool operator!=(const FMechanismKey& Other) const
+    {
+        return !(*this == Other);
+    }
+
+    friend uint32 GetTypeHash(const FMechanismKey& Key)
+    {
+        return HashCombine(HashCombine(GetTypeHash(Key.World), GetTypeHash(Key.Actor)), HashCombine(GetTypeHash(Key.Component), GetTypeHash(Key.MechanismFilepath)));
+    }
+
+    FName World;
+    FName Actor;
+    FName Component;
+    FName MechanismFilepath;
+};
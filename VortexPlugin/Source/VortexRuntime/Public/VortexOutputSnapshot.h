@@ -0,0 +1,100 @@
+#pragma once
+//Copyright(c) 2019 CM Labs Simulations Inc. All rights reserved.
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of
+//the sample code software and associated documentation files (the "Software"), to deal with
+//the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies
+//of the Software, and to permit persons to whom the Software is furnished to
+//do so, subject to the following conditions :
+//
+//Redistributions of source code must retain the above copyright notice,
+//this list of conditions and the following disclaimers.
+//Redistributions in binary form must reproduce the above copyright notice,
+//this list of conditions and the following disclaimers in the documentation
+//and/or other materials provided with the distribution.
+//Neither the names of CM Labs or Vortex Studio
+//nor the names of its contributors may be used to endorse or promote products
+//derived from this Software without specific prior written permission.
+//
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH THE
+//SOFTWARE.
+#include "CoreMinimal.h"
+#include "VortexFieldHandle.h"
+
+/// State of the subscribed outputs of a mechanism after a Vortex step
+struct FVortexOutputSnapshot
+{
+    FVortexOutputSnapshot();
+
+    /// Vortex frame and simulation time of the step, consumers can compare frames to detect skipped steps
+    uint32 Frame;
+    double SimulationTime;
+
+    /// Subscribed output fields, ordered like the subscribed fields of each data type
+    FVortexVHLBatchValues Outputs;
+
+    /// World transforms of the graphic nodes of the mechanism, in the order of the mechanism graphic nodes
+    TArray<FTransform> GraphicNodeTransforms;
+};
+
+///
+/// Lock-free channel publishing a snapshot of subscribed outputs of a mechanism after each Vortex step.
+///
+/// The channel is a triple buffer between the thread running the steps and a single consumer thread: the consumer always reads
+/// a complete snapshot, never blocks the steps and is never blocked by them. Each consumer thread needs its own channel.
+///
+/// The channel is obtained from UMechanismComponent::SubscribeOutputSnapshots() on the game thread, and can then be read from any thread.
+/// Releasing the last reference to it ends the subscription. It is unbound when the component is unregistered.
+///
+class VORTEXRUNTIME_API FVortexOutputSnapshotChannel
+{
+public:
+
+    FVortexOutputSnapshotChannel(const TArray<FVortexFieldHandle>& InOutputs, const TArray<VortexObjectHandle>& InGraphicNodes);
+
+    /// Returns the latest published snapshot. The reference stays valid until the next call to Read().
+    ///
+    /// @param[out] bNew  True if a snapshot was published since the previous call
+    ///
+    const FVortexOutputSnapshot& Read(bool& bNew);
+
+    /// Returns false once the mechanism component the channel subscribes to was unregistered
+    ///
+    bool IsBound() const { return bBound; }
+
+private:
+    friend class UMechanismComponent;
+    friend class FVortexRuntimeModule;
+    friend class FVortexSimulationThread;
+
+    /// Fills the back buffer with the current state of Vortex and publishes it.
+    ///
+    /// @note Single producer: only called by the thread running the steps, right after a step.
+    ///
+    void Publish();
+
+    void Unbind() { bBound = false; }
+
+    static constexpr uint32 DirtyFlag = 0x4;
+    static constexpr uint32 IndexMask = 0x3;
+
+    TArray<FVortexFieldHandle> Outputs;
+    TArray<VortexObjectHandle> GraphicNodes;
+
+    FVortexOutputSnapshot Buffers[3];
+
+    /// Buffer owned by the producer, buffer owned by the consumer, and buffer in between with a flag telling if it holds a new snapshot
+    int32 WriteIndex;
+    int32 ReadIndex;
+    TAtomic<uint32> SharedIndex;
+
+    TAtomic<bool> bBound;
+};
+
+using FVortexOutputSnapshotChannelPtr = TSharedPtr<FVortexOutputSnapshotChannel, ESPMode::ThreadSafe>;
@@ -27,9 +27,14 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 #include "Containers/Ticker.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/EngineTypes.h"
 #include "VortexIntegration/VortexIntegration.h"
 #include "VortexIntegration/VortexIntegrationTypes.h"
 #include "Runtime/Engine/Public/TimerManager.h"
+#include "VortexInputCommandQueue.h"
+#include "VortexOutputSnapshot.h"
+#include "VortexMechanismKey.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogVortex, Log, All);
 
@@ -38,7 +43,31 @@ class AVortexLidarActor;
 class UVortexLidarActorComponent;
 class UVortexApplicationBlueprintLib;
 class FVortexTerrain;
+class FVortexSimulationThread;
+enum class EVortexCatchUpBehavior : uint8;
 DECLARE_STATS_GROUP(TEXT("VortexRuntimeModule"), STATGROUP_VortexRuntimeModule, STATCAT_Advanced);
+
+/// Latest state of a graphic node notified by Vortex, see UVortexSettings::EnableGraphicNodeNotifications
+struct FVortexGraphicNodeUpdate
+{
+    FTransform Transform;
+    bool bVisible;
+};
+
+/// Steps Vortex in TG_PrePhysics of the simulated world, see UVortexSettings::EnableTickGroupIntegration
+struct FVortexStepTickFunction : public FTickFunction
+{
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override { return TEXT("FVortexStepTickFunction"); }
+};
+
+/// Joins the steps and synchronizes their outputs in TG_PostPhysics of the simulated world, see UVortexSettings::EnableTickGroupIntegration
+struct FVortexSyncTickFunction : public FTickFunction
+{
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override { return TEXT("FVortexSyncTickFunction"); }
+};
+
 /// Runtime module for Vortex Studio integration
 class FVortexRuntimeModule
     : public IModuleInterface
@@ -94,13 +123,20 @@ public:
 
     void BeginPlay(UMechanismComponent* Component);
 
-    void EndPlay(UMechanismComponent* Component);
+    void EndPlay(UMechanismComponent* Component, EEndPlayReason::Type EndPlayReason);
+
+    /// Returns true if a component ending play for this reason should put its mechanism back in the pool instead of unloading it:
+    /// when its streamed level is removed, or when play in editor ends with UVortexSettings::EnableWarmPlayInEditorRestart.
+    ///
+    bool ShouldPoolMechanismOnEndPlay(EEndPlayReason::Type EndPlayReason) const;
 
     void UpdateLidar(GraphicsLidarInfo& lidarInfo);
 
     void UpdateDepthCamera(GraphicsDepthCameraInfo& depthCameraInfo);
 
     void UpdateColorCamera(GraphicsColorCameraInfo& colorCameraInfo);
+
+    void OnVHLNotification(GraphicNotificationType Type, const VHLInfo& vhlInfo);
     //
     // Unregister mechanism component
     // Remove a reference to the Mechanism
@@ -110,15 +146,127 @@ public:
 
     //
     // Clear all references for mechanism components corresponding to a given Vortex Mechanism
+    // The mechanism is unloaded immediately, unless bImmediately is false in which case it is put back in the pool
+    //
+    void UnregisterAllComponents(const FMechanismKey& LoadedMechanismKey, bool bImmediately = true);
+
+    //
+    // Block until the step running on the simulation thread (pipelined simulation mode only), if any, is completed.
+    // Once this returns, the calling game thread code can safely call into the Vortex application until the next Tick().
+    //
+    void WaitForSimulationStep();
+
+    //
+    // Defer a command touching the Vortex application to the next step boundary if a step is currently running on the simulation thread.
+    //
+    // @return False if no step is in flight, in which case the command was not queued and the caller can execute it right away
+    //
+    bool DeferUntilStepBoundary(TFunction<void()>&& Command);
+
+    //
+    // Checks if a step is currently running on the simulation thread (pipelined simulation mode only).
+    //
+    bool IsSimulationStepInFlight() const;
+
+    //
+    // Checks if the mechanisms of components beginning play are loaded over the next frames, see UVortexSettings::EnableAsynchronousMechanismLoading.
+    //
+    bool IsLoadingMechanismsAsynchronously() const { return bAsynchronousMechanismLoading; }
+
+    //
+    // Number of mechanisms registered by playing components and not loaded yet.
+    //
+    int32 GetPendingMechanismLoadCount() const { return PendingMechanismLoads.Num(); }
+
+    //
+    // Defer the mechanism load of an editor component until its actor is selected or in view, see UVortexSettings::EnableLazyEditorMechanismLoading.
+    //
+    // @return False if the mechanism should be loaded right away, in which case the component was not deferred
+    //
+    bool DeferEditorComponent(UMechanismComponent* Component);
+
+    //
+    // Load the mechanisms of all the deferred editor components over the next frames.
+    //
+    void LoadAllEditorMechanisms();
+
+    //
+    // Number of editor components whose mechanism is not loaded yet.
+    //
+    int32 GetDeferredEditorComponentCount() const { return DeferredEditorComponents.Num(); }
+
+    //
+    // Checks if mechanism components should render a blend of the last two Vortex steps instead of the last step.
+    //
+    bool IsInterpolatingTransforms() const { return bInterpolateTransforms && !IsBatchMode(); }
+
+    //
+    // Blend factor between the previous (0) and the current (1) captured Vortex step, based on the time accumulated toward the next step.
+    // The captured steps can be several steps apart, in pipelined mode or when the step budget cut a frame short.
+    //
+    float GetInterpolationAlpha() const;
+
+    //
+    // Checks if Vortex runs a fixed number of steps per tick, regardless of the wall clock time (see UVortexSettings::BatchStepsPerTick).
+    //
+    bool IsBatchMode() const { return BatchStepsPerTick > 0; }
+
+    //
+    // Checks if the steps of the last tick should be reflected on the scene components and debug drawings.
+    // Always true, except in batch mode where visuals are only synchronized once every BatchVisualSyncInterval steps.
+    //
+    bool ShouldSyncVisuals() const { return bSyncVisuals; }
+
+    //
+    // Rolling ratio of simulated time over wall clock time.
+    //
+    double GetRealTimeFactor() const { return RealTimeFactor; }
+
+    //
+    // Checks if graphic node twins are moved from the node updates notified by Vortex instead of being read every frame.
+    //
+    bool IsPushingGraphicNodes() const { return bGraphicNodeNotifications && !IsInterpolatingTransforms(); }
+
+    //
+    // Checks if playing mechanism components are synchronized by the module instead of ticking individually (see UVortexSettings::EnableCentralizedMechanismTick).
+    //
+    bool IsTickingComponentsCentrally() const { return bCentralizedTick; }
+
+    //
+    // Route the node updates of a mechanism to the graphic node twins of a component, matched by Vortex node name.
+    //
+    // @param TwinNodeNames  Vortex node name of each graphic node twin of the component
+    // @param[out] Pushed    For each twin, true if its updates are notified
     //
-    void UnregisterAllComponents(FString LoadedMechanismKey);
+    void BindGraphicNodeTwins(UMechanismComponent* Component, const TArray<FString>& TwinNodeNames, TArray<bool>& Pushed);
+    void UnbindGraphicNodeTwins(UMechanismComponent* Component);
 
+    void OnGraphicNodeNotification(GraphicNotificationType Type, const GraphicNodeInfo& nodeInfo);
+
+    //
+    // Checks if Vortex is stepped and synchronized by tick functions of this world, instead of the core ticker (see UVortexSettings::EnableTickGroupIntegration).
+    // The tick functions follow the world the simulation was started in, and are registered on the first core tick after it changed.
+    //
+    bool IsIntegratedInWorldTick(const UWorld* World) const;
+
+    //
+    // Tick function stepping Vortex, in TG_PrePhysics. Actors setting VHL inputs from their tick, in TG_PrePhysics, should run before it:
+    //     FVortexRuntimeModule::Get().GetStepTickFunction().AddPrerequisite(Actor, Actor->PrimaryActorTick);
+    // Actors reading VHL outputs from their tick should tick in TG_PostPhysics after a playing mechanism component, which waits for the outputs sync:
+    //     Actor->AddTickPrerequisiteComponent(MechanismComponent);
+    //
+    FTickFunction& GetStepTickFunction() { return StepTickFunction; }
 
     // IModuleInterface implementation
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
     bool Tick(float);
 
+    //
+    // Runs the steps Vortex owes for DeltaTime, with the VHL inputs before and the outputs after. Called by Tick(), or by the step tick function.
+    //
+    void StepSimulation(float DeltaTime);
+
     UWorld* GetCurrentWorld() const;
     const TArray<AActor*>& GetMechanismActors() const;
 
@@ -152,13 +300,117 @@ private:
 
     void ShutdownVortex();
 
+    /// Returns true if the next steps can be handed to the simulation thread.
+    /// Sensor callbacks spawn and move actors, and terrain queries overlap the world, so they must be processed on the game thread.
+    ///
+    bool CanStepOnSimulationThread() const;
+
+    /// Sends the queued VHL inputs of all the registered components that are due at the start of the next step.
+    ///
+    void ApplyQueuedVHLInputs();
+
+    /// Sends the pending batched VHL inputs, and gathers the batched VHL outputs, of all the registered components.
+    ///
+    void FlushVHLBatchInputs();
+    void GatherVHLBatchOutputs();
+
+    /// Calls the VHL output change delegates of all the registered components, once the steps of a frame are done.
+    ///
+    void DispatchVHLOutputChanges();
+
+    /// Moves the graphic node twins bound to the nodes Vortex notified since the last call.
+    ///
+    void ApplyGraphicNodeUpdates();
+
+    /// Unloads the pooled mechanisms that expired or exceed the pool capacity, least recently released first,
+    /// until the unload budget is spent, at least one per call.
+    ///
+    void EvictPooledMechanisms();
+
+    /// Loads the pending mechanisms in registration order until the load budget is spent, at least one per call.
+    /// Starts the simulation requested in the meantime once none are left.
+    ///
+    void LoadPendingMechanisms();
+
+    /// Loads the mechanisms of the deferred editor components whose actor is selected or near a perspective viewport,
+    /// or all of them after LoadAllEditorMechanisms(), until the load budget is spent, at least one per call.
+    ///
+    void LoadDeferredEditorMechanisms();
+
+    /// Returns the input command queues of all the registered components.
+    ///
+    TArray<FVortexInputCommandQueuePtr> GetInputCommandQueues() const;
+
+    /// Returns the output snapshot channels still referenced outside of their component, and releases the others
+    TArray<FVortexOutputSnapshotChannelPtr> GetOutputSnapshotChannels();
+
+    /// Join point of the pipelined simulation mode, outputs must be ready before any world starts ticking.
+    ///
+    void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+    /// Centralized mechanism tick, synchronizes the scene components of the playing mechanism components of the world once its actors ticked.
+    ///
+    void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+    /// Synchronizes the scene components of the centrally ticked mechanism components of the world, see OnWorldPostActorTick().
+    ///
+    void SyncMechanismComponents(UWorld* World);
+
+    /// Joins the steps of the frame and applies their outputs, from the sync tick function.
+    ///
+    void SyncSimulationOutputs(UWorld* World);
+
+    /// Registers the step and sync tick functions in the world, and makes the playing mechanism components of the world tick after the sync.
+    ///
+    void RegisterTickFunctions(UWorld* World);
+    void UnregisterTickFunctions();
+    void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+    /// Adds or removes the sync tick function from the prerequisites of a playing mechanism component tick.
+    ///
+    void SetSyncPrerequisite(UMechanismComponent* Component, bool bEnabled);
+
+    /// Reports the time between the end of the last step and the end of the world tick that displays its outputs, once per step.
+    ///
+    void RecordStepToDisplayLatency();
+
+    /// Keeps the outputs of the step that just completed in every registered component, for transform interpolation.
+    ///
+    void CaptureStepOutputs();
+
+    /// Sets the visual update interval of every playing mechanism component from its distance, screen size and visibility
+    /// from the player cameras, a few times per second.
+    ///
+    void UpdateMechanismSignificance();
+
+    /// Returns the number of frames between visual updates of a mechanism component, 0 to stop updating it.
+    ///
+    /// @param Views  Location of each player camera, and the tangent of half its field of view
+    ///
+    int32 GetVisualUpdateInterval(const UMechanismComponent* Component, const TArray<TPair<FVector, float>>& Views) const;
+
+    /// Feeds the rolling average step cost used by the step scheduler.
+    ///
+    void RecordStepCost(double Duration, int32 StepCount);
+
+    /// Returns the number of steps that fit in the step budget, given the rolling average step cost.
+    ///
+    int32 GetBudgetedStepCount() const;
+
+    /// Feeds the smoothed real time factor with the steps actually run for a frame of DeltaTime seconds.
+    ///
+    void RecordRealTimeFactor(int32 StepCount, float DeltaTime);
+
     UObject* CurrentWorldContext;
 
 #if WITH_EDITOR
     FDelegateHandle PieEndedEventBinding;
     FDelegateHandle PieSingleStepEventBinding;
 
+    FDelegateHandle PieStartedEventBinding;
+
     void OnPieEnded(bool bIsSimulating);
+    void OnPieStarted(bool bIsSimulating);
     void OnPieSingleStep(bool bIsSimulating);
 
     bool bLastUseFixedFrameRate;
@@ -173,19 +425,156 @@ private:
     FDelegateHandle TickDelegateHandle;
     FDirectoryPath VortexStudioBinDir;
 
-    /// Registered components
-    TArray<AActor*> MechanismActors;
-    TMultiMap<FString, UMechanismComponent*> MechanismComponents;
+    /// Pipelined simulation mode. Null when Vortex is stepped synchronously from Tick().
+    FVortexSimulationThread* SimulationThread;
+    FDelegateHandle WorldTickStartBinding;
+
+    /// Significance based updates, settings cached at startup
+    bool bSignificanceUpdates;
+    float SignificanceNearDistance;
+    float SignificanceFarDistance;
+    float SignificanceMinScreenSize;
+    int32 SignificanceMidRangeInterval;
+    int32 SignificanceFarInterval;
+    int32 SignificanceHiddenInterval;
+    double LastSignificanceUpdateTime;
+
+    /// Centralized mechanism tick, setting cached at startup, and the playing components it synchronizes
+    bool bCentralizedTick;
+    FDelegateHandle WorldPostActorTickBinding;
+    TArray<UMechanismComponent*> CentrallyTickedComponents;
+
+    /// Tick group integration, setting cached at startup, and the world the tick functions are registered in
+    friend struct FVortexStepTickFunction;
+    friend struct FVortexSyncTickFunction;
+    bool bTickGroupIntegration;
+    FVortexStepTickFunction StepTickFunction;
+    FVortexSyncTickFunction SyncTickFunction;
+    TWeakObjectPtr<UWorld> TickFunctionsWorld;
+    FDelegateHandle WorldCleanupBinding;
+
+    /// End time of the last step (FPlatformTime::Seconds()), and of the last step whose outputs were displayed
+    double LastStepEndTime;
+    double LastDisplayedStepEndTime;
+
+    /// Commands received while a step was in flight, executed at the next step boundary
+    TArray<TFunction<void()>> StepBoundaryCommands;
+
+    /// Asynchronous mechanism loading, settings cached at startup
+    bool bAsynchronousMechanismLoading;
+    double MechanismLoadBudget;
+
+    /// Keys of the mechanisms waiting to be loaded by LoadPendingMechanisms(), in registration order
+    TArray<FMechanismKey> PendingMechanismLoads;
+
+    /// UVortexApplicationBlueprintLib::StartSimulation() was called while mechanisms were pending
+    bool bStartSimulationWhenLoaded;
+
+    /// Lazy editor mechanism loading, settings cached at startup
+    bool bLazyEditorMechanismLoading;
+    double EditorMechanismLoadDistanceSquared;
+
+    /// Editor components registered without loading their mechanism, see LoadDeferredEditorMechanisms()
+    TArray<UMechanismComponent*> DeferredEditorComponents;
+    double LastDeferredEditorMechanismsUpdateTime;
+
+    /// LoadAllEditorMechanisms() was called, cleared once no deferred editor component is left
+    bool bLoadAllEditorMechanisms;
+
+    /// Transform interpolation mode, cached from the settings at startup
+    bool bInterpolateTransforms;
+
+    /// Steps run since the last capture of the step outputs, and between the last two captures
+    int32 StepsSinceCapture;
+    int32 CapturedStepGap;
+
+    /// Step scheduler, settings cached at startup
+    double StepBudget;
+    EVortexCatchUpBehavior CatchUpBehavior;
+    int32 MaxStepDebt;
+    double AverageStepCost;
+
+    /// AverageStepCost was measured in Simulating mode
+    bool bStepCostSimulating;
+
+    /// Speed requested by UVortexApplicationBlueprintLib::StartSimulation()
+    float TargetSpeedMultiplier;
+
+    /// Batch mode, settings cached at startup
+    int32 BatchStepsPerTick;
+    int32 BatchVisualSyncInterval;
+    int32 StepsSinceVisualSync;
+    bool bSyncVisuals;
+
+    double RealTimeFactor;
+
+    /// Frame time of the steps running on the simulation thread, their real time factor is recorded when they are joined
+    float PipelinedStepsDeltaTime;
+
+    /// Set when pipelined steps are joined or a VHL update is notified, output changes are dispatched at the start of the next world tick.
+    /// Notifications are only sent from Vortex calls, which are joined before it is read, so it needs no lock.
+    bool bVHLOutputChangesPending;
+
+    /// Graphic node notifications, setting cached at startup
+    bool bGraphicNodeNotifications;
+
+    /// Node ids of each loaded mechanism by Vortex node name, 0 when the name is not unique in the mechanism
+    TMap<FMechanismKey, TMap<FString, uint64>> MechanismGraphicNodes;
+
+    /// Twins bound to each notified node, as the component and the index of the twin in the component
+    TMultiMap<uint64, TPair<TWeakObjectPtr<UMechanismComponent>, int32>> GraphicNodeTwins;
+
+    /// Latest update of each node notified since the last ApplyGraphicNodeUpdates(), only written by the Vortex steps
+    TMap<uint64, FVortexGraphicNodeUpdate> PendingGraphicNodeUpdates;
+
+    /// A loaded mechanism and the components sharing it, the mechanism is released with its last component
+    struct FMechanismRegistryEntry
+    {
+        VortexObjectHandle VortexObject = nullptr;
+        TArray<UMechanismComponent*> Components;
+
+        /// Waiting in PendingMechanismLoads, VortexObject is null until then
+        bool bLoadPending = false;
+    };
+
+    /// Registered components, by the key of the mechanism they share
+    TMap<FMechanismKey, FMechanismRegistryEntry> Mechanisms;
+
+    /// Number of registered components of each actor, and the actors as an array, rebuilt on demand for GetMechanismActors()
+    TMap<AActor*, int32> MechanismActors;
+    mutable TArray<AActor*> MechanismActorList;
+    mutable bool bMechanismActorListDirty;
+
+    /// A freed mechanism available for reuse by a component registering with the same key
+    struct FPooledMechanism
+    {
+        FMechanismKey Key;
+        VortexObjectHandle VortexObject;
+        double ReleaseTime;
+
+        /// Freed when play in editor ended, kept regardless of the pool lifetime and capacity until the next session started
+        bool bRetainedForRestart;
+    };
+
+    /// Pool of freed mechanisms, least recently released first
+    TArray<FPooledMechanism> MechanismPool;
+
+    /// Mechanism pool, settings cached at startup
+    bool bWarmPlayInEditorRestart;
 
-    /// Short lived pool of freed mechanisms available for reuse
-    TMultiMap<FString, VortexObjectHandle> MechanismPool;
+    /// Set from the end of a play in editor session until the next one started, with warm restarts only
+    bool bEndingPlayInEditor;
+    double MechanismPoolLifetime;
+    int32 MechanismPoolCapacity;
+    double MechanismUnloadBudget;
 
-    FString RegisteringMechanismComponent;
-    TMap<FString, TArray<GraphicsLidarInfo>> MechanismLidars;
+    /// Mechanism being loaded or unloaded, the graphics callbacks of Vortex are attributed to it
+    FMechanismKey RegisteringMechanism;
+    TMap<FMechanismKey, TArray<GraphicsLidarInfo>> MechanismLidars;
     TMap<uint64_t, AActor*> Lidars;
-    TMap<FString, TArray<GraphicsDepthCameraInfo>> MechanismDepthCamera;
+    TMap<FMechanismKey, TArray<GraphicsDepthCameraInfo>> MechanismDepthCamera;
     TMap<uint64_t, AActor*> DepthCameras;
-    TMap<FString, TArray<GraphicsColorCameraInfo>> MechanismColorCamera;
+    TMap<FMechanismKey, TArray<GraphicsColorCameraInfo>> MechanismColorCamera;
     TMap<uint64_t, AActor*> ColorCameras;
 
     FVortexTerrain* Terrain;
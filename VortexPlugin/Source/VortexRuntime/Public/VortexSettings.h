@@ -45,6 +45,17 @@ public:
     FString VortexMaterialName;
 };
 
+/// Behavior of the Vortex step scheduler when a frame cannot run all the steps it owes within the step budget
+UENUM()
+enum class EVortexCatchUpBehavior : uint8
+{
+    /// The steps that did not fit are run over the following frames. The simulation temporarily runs slower than real time.
+    SlowMotion UMETA(DisplayName = "Slow Motion"),
+
+    /// The steps that did not fit are discarded. The simulation skips that time.
+    Drop UMETA(DisplayName = "Drop"),
+};
+
 //
 // settings for the vortex application
 //
@@ -122,6 +133,269 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Vortex|Static Collision|Terrain Paging", meta = (DisplayName = "Safety Band Size", ConfigRestartRequired = true))
     double TerrainPagingSafetyBandSize;
 
+    /// Pipelined Simulation
+    ///
+    /// Runs the Vortex steps on a dedicated simulation thread. The steps triggered at the end of a frame run while the game thread
+    /// finishes that frame, and are joined before the worlds of the next frame start ticking. VHL inputs set while a step is running
+    /// are applied at the next step boundary.
+    ///
+    /// Mechanisms containing sensors (LiDAR, depth camera, color camera) are always stepped on the game thread, and so is everything
+    /// when a terrain collision detection is enabled, since the terrain queries overlap the world.
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation", meta = (DisplayName = "Enable Pipelined Simulation", ConfigRestartRequired = true))
+    bool EnablePipelinedSimulation;
+
+    /// Transform Interpolation
+    ///
+    /// Mechanism components render a blend of the last two Vortex steps, weighted by the time accumulated toward the next step,
+    /// instead of snapping to the last step. This removes the stutter seen when Unreal and Vortex run at different rates,
+    /// at the cost of rendering up to one Vortex step behind the simulation.
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation", meta = (DisplayName = "Enable Transform Interpolation", ConfigRestartRequired = true))
+    bool EnableTransformInterpolation;
+
+    /// Graphic Node Notifications
+    ///
+    /// Graphic node twins are moved from the updates Vortex sends for the nodes that changed during a step, applied in one batch after the steps,
+    /// instead of reading the transform of every node every frame. Node visibility changes are applied as well.
+    /// Twins whose Vortex node name is not unique in their mechanism keep being read every frame.
+    ///
+    /// Ignored when transform interpolation is enabled, which needs the state of every node after each step.
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation", meta = (DisplayName = "Enable Graphic Node Notifications", ConfigRestartRequired = true))
+    bool EnableGraphicNodeNotifications;
+
+    /// Centralized Mechanism Tick
+    ///
+    /// Playing mechanism components do not tick individually. The runtime module synchronizes the scene components of all of them
+    /// in a single loop once the actors of a world have ticked, sharing the checks and state every component would otherwise repeat.
+    /// Components in editor worlds keep their own tick.
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation", meta = (DisplayName = "Enable Centralized Mechanism Tick", ConfigRestartRequired = true))
+    bool EnableCentralizedMechanismTick;
+
+    /// Enable Tick Group Integration
+    ///
+    /// Vortex is stepped in TG_PrePhysics of the simulated world, and the outputs are synchronized in TG_PostPhysics of the same frame,
+    /// instead of stepping from the core ticker at a point of the frame unrelated to the world tick. Rendered poses no longer lag
+    /// the simulation by a frame. Steps follow the world delta time, with its time dilation and maximum delta time.
+    /// Actors setting VHL inputs must tick before TG_PrePhysics ends and actors reading outputs must tick in TG_PostPhysics or later,
+    /// see FVortexRuntimeModule::GetStepTickFunction().
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation", meta = (DisplayName = "Enable Tick Group Integration", ConfigRestartRequired = true))
+    bool EnableTickGroupIntegration;
+
+    /// Step Budget
+    ///
+    /// Specifies the maximum time, in milliseconds, spent updating the Vortex application per frame.
+    /// The number of steps run in a frame is limited using the measured average cost of a step, at least one step is always run,
+    /// and the steps left are skipped once the measured time exceeds the budget. Until the cost of a step is measured,
+    /// at most 4 steps are run per frame. Set to 0 to always run up to 4 steps per frame, regardless of their cost.
+    ///
+    /// Default: 10 ms
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation", meta = (DisplayName = "Step Budget (ms)", ClampMin = "0.0", ConfigRestartRequired = true))
+    float StepBudget;
+
+    /// Catch Up Behavior
+    ///
+    /// Specifies what happens to the steps that did not fit in the step budget of a frame.
+    ///
+    /// Default: Slow Motion
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation", meta = (DisplayName = "Catch Up Behavior", ConfigRestartRequired = true))
+    EVortexCatchUpBehavior CatchUpBehavior;
+
+    /// Max Step Debt
+    ///
+    /// Specifies the maximum number of steps carried over to the following frames in Slow Motion.
+    /// The time owed beyond that is discarded, so a long hitch does not keep the simulation catching up for many frames.
+    ///
+    /// Default: 4 steps
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation", meta = (DisplayName = "Max Step Debt", ClampMin = "1", ConfigRestartRequired = true))
+    int32 MaxStepDebt;
+
+    /// Batch Steps Per Tick
+    ///
+    /// Runs this number of Vortex steps per engine tick, regardless of the elapsed wall clock time, for faster than real-time simulations
+    /// such as data generation. The step budget, catch up behavior and the speed multiplier of Start Simulation are ignored in that mode.
+    /// Set to 0 to step Vortex in real time.
+    ///
+    /// Default: 0 (disabled)
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Batch Mode", meta = (DisplayName = "Steps Per Tick", ClampMin = "0", ConfigRestartRequired = true))
+    int32 BatchStepsPerTick;
+
+    /// Batch Visual Sync Interval
+    ///
+    /// In batch mode, mechanism components, graphic node twins and debug drawings are only updated once every this number of steps.
+    ///
+    /// Default: 1 step
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Batch Mode", meta = (DisplayName = "Visual Sync Interval", ClampMin = "1", ConfigRestartRequired = true))
+    int32 BatchVisualSyncInterval;
+
+    /// Significance Based Updates
+    ///
+    /// Graphic node twins and mapped components of mechanisms far from the player cameras, small on screen, or not rendered recently,
+    /// are updated less often. Vortex still steps every mechanism at full rate, only the visuals are affected.
+    /// Mechanisms rendering their twins with instances are only evaluated on the distance and screen size of the instances.
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Significance", meta = (DisplayName = "Enable Significance Based Updates", ConfigRestartRequired = true))
+    bool EnableSignificanceBasedUpdates;
+
+    /// Near Distance
+    ///
+    /// Mechanisms closer than this to a player camera, in centimeters, are updated every frame.
+    ///
+    /// Default: 5000 cm
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Significance", meta = (DisplayName = "Near Distance", ClampMin = "0.0", ConfigRestartRequired = true))
+    float SignificanceNearDistance;
+
+    /// Far Distance
+    ///
+    /// Mechanisms farther than this from every player camera, in centimeters, or covering less of the screen than the Min Screen Size, use the far update interval.
+    /// Mechanisms in between use the mid range update interval.
+    ///
+    /// Default: 20000 cm
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Significance", meta = (DisplayName = "Far Distance", ClampMin = "0.0", ConfigRestartRequired = true))
+    float SignificanceFarDistance;
+
+    /// Min Screen Size
+    ///
+    /// Fraction of the screen height covered by the bounds of a mechanism below which it is considered far.
+    ///
+    /// Default: 0.02
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Significance", meta = (DisplayName = "Min Screen Size", ClampMin = "0.0", ClampMax = "1.0", ConfigRestartRequired = true))
+    float SignificanceMinScreenSize;
+
+    /// Mid Range Update Interval
+    ///
+    /// Mid range mechanisms are updated once every this number of frames.
+    ///
+    /// Default: 4 frames
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Significance", meta = (DisplayName = "Mid Range Update Interval", ClampMin = "1", ConfigRestartRequired = true))
+    int32 SignificanceMidRangeInterval;
+
+    /// Far Update Interval
+    ///
+    /// Far mechanisms are updated once every this number of frames.
+    ///
+    /// Default: 16 frames
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Significance", meta = (DisplayName = "Far Update Interval", ClampMin = "1", ConfigRestartRequired = true))
+    int32 SignificanceFarInterval;
+
+    /// Hidden Update Interval
+    ///
+    /// Mechanisms that were not rendered recently, because they are off-screen or occluded, are updated once every this number of frames.
+    /// Set to 0 to never update them until they are rendered again. Their bounds then stay where they were last updated,
+    /// so a mechanism moving into view while hidden only reappears once its stale position is rendered.
+    ///
+    /// Default: 64 frames
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Simulation|Significance", meta = (DisplayName = "Hidden Update Interval", ClampMin = "0", ConfigRestartRequired = true))
+    int32 SignificanceHiddenInterval;
+
+    /// Asynchronous Mechanism Loading
+    ///
+    /// Mechanisms of components beginning play are loaded over the next frames, a few at a time within the Mechanism Load Budget, instead of
+    /// all at once in BeginPlay. The component stays pending until then: the VHL inputs set in the meantime are applied once it is loaded,
+    /// and OnMechanismLoaded is broadcast. Starting the simulation waits for the pending mechanisms.
+    /// Mechanisms of editor components are always loaded right away.
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Loading", meta = (DisplayName = "Enable Asynchronous Mechanism Loading", ConfigRestartRequired = true))
+    bool EnableAsynchronousMechanismLoading;
+
+    /// Mechanism Load Budget
+    ///
+    /// Time spent loading pending mechanisms per frame, in milliseconds. At least one mechanism is loaded per frame, whatever its cost.
+    ///
+    /// Default: 8 ms
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Loading", meta = (DisplayName = "Mechanism Load Budget (ms)", ClampMin = "0.0", ConfigRestartRequired = true))
+    float MechanismLoadBudget;
+
+    /// Mechanism Pool Lifetime
+    ///
+    /// Freed mechanisms are kept loaded for this many seconds, to be reused by a component registering again with the same actor and mechanism,
+    /// such as the actors of a streamed level coming back. Playing components only free their mechanism this way when their level is streamed out,
+    /// they otherwise unload it right away when they end play. Set to 0 to only keep them until the next frame.
+    ///
+    /// Default: 0 s
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Loading", meta = (DisplayName = "Mechanism Pool Lifetime (s)", ClampMin = "0.0", ConfigRestartRequired = true))
+    float MechanismPoolLifetime;
+
+    /// Warm Play In Editor Restart
+    ///
+    /// When a play in editor session ends, the simulation is stopped, which restores the state the mechanisms had in Editing mode,
+    /// and the mechanisms are kept loaded for the next session instead of being unloaded, regardless of the pool lifetime and capacity.
+    /// The next session reuses the mechanisms of the actors it finds, and the sensor actors are spawned again without loading anything.
+    /// The mechanisms the next session does not reuse are then evicted like any pooled mechanism.
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Loading", meta = (DisplayName = "Enable Warm Play In Editor Restart", ConfigRestartRequired = true))
+    bool EnableWarmPlayInEditorRestart;
+
+    /// Mechanism Pool Capacity
+    ///
+    /// Maximum number of freed mechanisms kept loaded, the least recently freed ones are unloaded first.
+    ///
+    /// Default: 16
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Loading", meta = (DisplayName = "Mechanism Pool Capacity", ClampMin = "0", ConfigRestartRequired = true))
+    int32 MechanismPoolCapacity;
+
+    /// Mechanism Unload Budget
+    ///
+    /// Time spent unloading expired pooled mechanisms per frame, in milliseconds. At least one mechanism is unloaded per frame, whatever its cost.
+    ///
+    /// Default: 4 ms
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Loading", meta = (DisplayName = "Mechanism Unload Budget (ms)", ClampMin = "0.0", ConfigRestartRequired = true))
+    float MechanismUnloadBudget;
+
+    /// Lazy Editor Mechanism Loading
+    ///
+    /// In the editor, mechanisms are only loaded when their actor is selected, when it is within the editor load distance of a perspective viewport,
+    /// or when all of them are requested with the Vortex.LoadAllEditorMechanisms console command. Until then, the actor shows its own components only.
+    /// Loaded mechanisms stay loaded until their component is unregistered. Playing components always load their mechanism.
+    ///
+    /// Default: false
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Loading", meta = (DisplayName = "Enable Lazy Editor Mechanism Loading", ConfigRestartRequired = true))
+    bool EnableLazyEditorMechanismLoading;
+
+    /// Editor Mechanism Load Distance
+    ///
+    /// Distance from a perspective viewport within which the mechanisms of the editor are loaded, in centimeters. Set to 0 to only load them on selection.
+    ///
+    /// Default: 10000 cm
+    ///
+    UPROPERTY(config, EditAnywhere, Category = "Vortex|Loading", meta = (DisplayName = "Editor Mechanism Load Distance (cm)", ClampMin = "0.0", ConfigRestartRequired = true, EditCondition = "EnableLazyEditorMechanismLoading"))
+    float EditorMechanismLoadDistance;
+
 private:
 
     bool IsMaterialMappingErrorBeingShown;